@@ -11,4 +11,20 @@ namespace ipd {
     int ALLC::complexity() const {
         return 1;
     }
+
+    std::size_t ALLC::historyDepth() const {
+        return 0;
+    }
+
+    bool ALLC::isDeterministic() const {
+        return true;
+    }
+
+    std::optional<std::uint64_t> ALLC::stateSnapshot() const {
+        return 0;
+    }
+
+    std::optional<TransitionTable> ALLC::transitionTable() const {
+        return TransitionTable{ { 1.0 }, { { 0, 0, 0, 0 } } };
+    }
 }
@@ -3,10 +3,14 @@
 #include "Strategy.h"
 
 namespace ipd {
-    class ALLC : public Strategy {
+    class ALLC final : public Strategy {
     public:
         std::string name() const override;
         Move nextMove(const MatchState& state, int selfIndex, Random& rng) override;
         int complexity() const override;
+        std::size_t historyDepth() const override;
+        bool isDeterministic() const override;
+        std::optional<std::uint64_t> stateSnapshot() const override;
+        std::optional<TransitionTable> transitionTable() const override;
     };
 }
\ No newline at end of file
@@ -11,4 +11,20 @@ namespace ipd {
     int ALLD::complexity() const {
         return 1;
     }
+
+    std::size_t ALLD::historyDepth() const {
+        return 0;
+    }
+
+    bool ALLD::isDeterministic() const {
+        return true;
+    }
+
+    std::optional<std::uint64_t> ALLD::stateSnapshot() const {
+        return 0;
+    }
+
+    std::optional<TransitionTable> ALLD::transitionTable() const {
+        return TransitionTable{ { 0.0 }, { { 0, 0, 0, 0 } } };
+    }
 }
\ No newline at end of file
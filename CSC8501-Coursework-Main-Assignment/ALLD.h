@@ -2,10 +2,14 @@
 
 #include "Strategy.h"
 namespace ipd {
-    class ALLD : public Strategy {
+    class ALLD final : public Strategy {
     public:
         std::string name() const override;
         Move nextMove(const MatchState& state, int selfIndex, Random& rng) override;
         int complexity() const override;
+        std::size_t historyDepth() const override;
+        bool isDeterministic() const override;
+        std::optional<std::uint64_t> stateSnapshot() const override;
+        std::optional<TransitionTable> transitionTable() const override;
     };
 }
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include "BuiltinStrategies.h"
+
+#include <typeinfo>
+
+namespace ipd {
+    namespace {
+        template <typename Builtin>
+        bool isBuiltin(const std::type_info& type, Strategy& strategy, BuiltinStrategyRef& ref) {
+            if (type != typeid(Builtin)) {
+                return false;
+            }
+            ref = static_cast<Builtin*>(&strategy);
+            return true;
+        }
+    }
+
+    BuiltinStrategyRef classifyBuiltin(Strategy& strategy) {
+        const std::type_info& type = typeid(strategy);
+        BuiltinStrategyRef ref = &strategy;
+        isBuiltin<ALLC>(type, strategy, ref)
+            || isBuiltin<ALLD>(type, strategy, ref)
+            || isBuiltin<TFT>(type, strategy, ref)
+            || isBuiltin<GRIM>(type, strategy, ref)
+            || isBuiltin<PAVLOV>(type, strategy, ref)
+            || isBuiltin<CTFT>(type, strategy, ref)
+            || isBuiltin<PROBER>(type, strategy, ref)
+            || isBuiltin<RND>(type, strategy, ref)
+            || isBuiltin<Empath>(type, strategy, ref)
+            || isBuiltin<Reflector>(type, strategy, ref)
+            || isBuiltin<MEM1>(type, strategy, ref);
+        return ref;
+    }
+}
\ No newline at end of file
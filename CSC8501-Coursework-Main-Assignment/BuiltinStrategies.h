@@ -0,0 +1,24 @@
+#pragma once
+
+#include <variant>
+
+#include "ALLC.h"
+#include "ALLD.h"
+#include "CTFT.h"
+#include "Empath.h"
+#include "GRIM.h"
+#include "MEM1.h"
+#include "PAVLOV.h"
+#include "PROBER.h"
+#include "RND.h"
+#include "Reflector.h"
+#include "TFT.h"
+
+namespace ipd {
+    // A strategy seen through its concrete type when it is one of the (final) built-ins, so
+    // code visiting it calls nextMove directly and the optimiser can inline it. Anything
+    // else, e.g. strategies registered at run time, stays behind the virtual interface.
+    using BuiltinStrategyRef = std::variant<Strategy*, ALLC*, ALLD*, TFT*, GRIM*, PAVLOV*, CTFT*, PROBER*, RND*, Empath*, Reflector*, MEM1*>;
+
+    BuiltinStrategyRef classifyBuiltin(Strategy& strategy);
+}
\ No newline at end of file
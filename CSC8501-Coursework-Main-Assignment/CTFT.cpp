@@ -41,4 +41,23 @@ namespace ipd {
     int CTFT::complexity() const {
         return 3;
     }
+
+    std::size_t CTFT::historyDepth() const {
+        return 1;
+    }
+
+    bool CTFT::isDeterministic() const {
+        return true;
+    }
+
+    std::optional<std::uint64_t> CTFT::stateSnapshot() const {
+        return m_contrite ? 1u : 0u;
+    }
+
+    // States: 0 cooperate, 1 defect, 2 cooperate while contrite. Contrition starts after an
+    // own defection the opponent met with cooperation and lasts until the opponent cooperates.
+    std::optional<TransitionTable> CTFT::transitionTable() const {
+        const std::array<std::size_t, 4> plain{ 0, 1, 2, 1 };
+        return TransitionTable{ { 1.0, 0.0, 1.0 }, { plain, plain, { 0, 2, 0, 2 } } };
+    }
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include "Strategy.h"
 
 namespace ipd {
-    class CTFT : public Strategy {
+    class CTFT final : public Strategy {
     public:
         CTFT();
 
@@ -11,6 +11,10 @@ namespace ipd {
         Move nextMove(const MatchState& state, int selfIndex, Random& rng) override;
         void reset() override;
         int complexity() const override;
+        std::size_t historyDepth() const override;
+        bool isDeterministic() const override;
+        std::optional<std::uint64_t> stateSnapshot() const override;
+        std::optional<TransitionTable> transitionTable() const override;
 
     private:
         bool m_contrite;
@@ -18,6 +18,8 @@
 #include <stdexcept>
 #include <unordered_map>
 
+#include "LandscapeScan.h"
+
 namespace ipd {
     namespace {
         using OptionalString = std::optional<std::string>;
@@ -30,8 +32,12 @@ namespace ipd {
             std::optional<Payoff> payoffs;
             std::optional<std::vector<std::string>> strategies;
             std::optional<int> generations;
-            std::optional<int> population;
+            std::optional<std::int64_t> population;
             std::optional<double> mutation;
+            std::optional<std::string> fitness;
+            std::optional<std::string> dynamics;
+            std::optional<std::string> integrator;
+            std::optional<double> timeStep;
             std::optional<double> complexityPenalty;
             std::optional<std::string> format;
             std::optional<std::string> output;
@@ -41,6 +47,20 @@ namespace ipd {
             OptionalString loadFile;
             std::optional<bool> scbEnabled;
             std::optional<std::unordered_map<std::string, int>> scbCosts;
+            std::optional<int> threads;
+            std::optional<std::string> rngEngine;
+            std::optional<bool> cycleSkip;
+            std::optional<bool> matchCache;
+            std::optional<bool> lockstep;
+            std::optional<bool> exact;
+            std::optional<std::string> horizon;
+            std::optional<bool> symmetric;
+            std::optional<bool> matrix;
+            std::optional<int> landscape;
+            std::optional<double> ciTarget;
+            std::optional<int> maxRepeats;
+            std::optional<std::pair<int, int>> replay;
+            std::optional<bool> benchmark;
         };
 
         void exitWithError(const std::string& message) {
@@ -53,16 +73,36 @@ namespace ipd {
                 "Usage: ipd [options]\n"
                 "  --rounds N\n"
                 "  --repeats N\n"
+                "  --ci-target WIDTH          # add repeats (batches, first of --repeats) until every 95% CI is at most WIDTH wide\n"
+                "  --max-repeats N            # cap for --ci-target (default 1000); strategies still wider report repeats needed as NA\n"
                 "  --epsilon FLOAT             # noise probability per move (0..1)\n"
-                "  --strategies LIST           # e.g. ALLC,ALLD,TFT,GRIM,PAVLOV,RND(0.3),CTFT,PROBER,Empath,Reflector\n"
+                "  --strategies LIST           # e.g. ALLC,ALLD,TFT,GRIM,PAVLOV,RND(0.3),CTFT,PROBER,Empath,Reflector,MEM1(pCC,pCD,pDC,pDD)\n"
                 "  --payoffs T,R,P,S           # e.g. 5,3,1,0\n"
                 "  --evolve 0/1\n"
                 "  --generations N\n"
-                "  --population N\n"
+                "  --population N             # up to 10^18; sampling cost does not grow with N\n"
                 "  --mutation FLOAT\n"
-                "  --format {text|csv|json}   # output format only\n"
+                "  --fitness {tournament|matrix}  # evolution fitness: re-run the tournament each generation, or weight one payoff matrix by the population\n"
+                "  --dynamics {wright-fisher|replicator}  # sample a finite population, or integrate the replicator equation over shares\n"
+                "  --integrator {rk4|adaptive}  # replicator integrator: fixed-step RK4 or error-controlled Dormand-Prince\n"
+                "  --step FLOAT               # replicator step in generations (default 0.1; initial step when adaptive)\n"
+                "  --format {text|csv|json|binary}  # output format only; binary (IPDM/IPDL) needs --matrix or --landscape, and --output\n"
                 "  --output FILE              # output destination only (defaults to stdout)\n"
                 "  --seed N\n"
+                "  --threads N                # worker threads for the round robin (results do not depend on N)\n"
+                "  --replay REPEAT,PAIR       # re-play one match of a seeded tournament and print its trace\n"
+                "  --benchmark                # time one evolution generation at populations 10^3..10^9 (--generations per size, default 1000)\n"
+                "  --rng {philox|xoshiro|mt19937}  # per-match random streams; mt19937 reproduces legacy shared-stream runs\n"
+                "  --cycle-skip 0/1           # shortcut noise-free matches once both strategies repeat a state\n"
+                "  --match-cache 0/1          # reuse noise-free results of deterministic pairs across repeats and generations\n"
+                "  --lockstep 0/1             # play up to 64 repeats of ALLC/ALLD/TFT/GRIM/PAVLOV/CTFT/Reflector pairings side by side\n"
+                "  --exact                    # exact expected scores for pairings of ALLC/ALLD/TFT/GRIM/PAVLOV/CTFT/RND/MEM1 (no sampling noise);\n"
+                "                             #   MEM1-vs-MEM1 pairings are always exact;\n"
+                "                             #   first defection / echo length read NA for strategies with an exact pairing\n"
+                "  --horizon {finite|stationary}  # --exact totals: over the actual rounds, or rounds x the long-run mean per round\n"
+                "  --symmetric                # play each unordered pair once (plus self-play), weighting samples to match the full schedule\n"
+                "  --matrix                   # report mean score and 95% CI of every row strategy against every column strategy\n"
+                "  --landscape N              # score MEM1 on an N^4 grid (N = 2..64) of (pCC,pCD,pDC,pDD) in [0,1] against --strategies\n"
                 "  --save FILE                 # save effective config to JSON (includes scb)\n"
                 "  --load FILE                 # load config from JSON (command line overrides loaded values)\n"
                 "  --scb [MAP]                # enable SCB; no MAP uses default complexity; MAP overrides provided entries.\n"
@@ -98,11 +138,30 @@ namespace ipd {
             return value;
         }
 
+        // Splits a comma-separated list, keeping commas inside parentheses so parameterised
+        // names such as MEM1(1,0,1,0) stay whole.
+        std::vector<std::string> splitList(std::string_view value) {
+            std::vector<std::string> tokens(1);
+            int depth = 0;
+            for (const char character : value) {
+                if (character == ',' && depth == 0) {
+                    tokens.emplace_back();
+                    continue;
+                }
+                if (character == '(') {
+                    ++depth;
+                }
+                else if (character == ')' && depth > 0) {
+                    --depth;
+                }
+                tokens.back().push_back(character);
+            }
+            return tokens;
+        }
+
         std::vector<std::string> parseStrategies(std::string_view value) {
-            std::stringstream stream{ std::string(value) };
             std::vector<std::string> names;
-            std::string token;
-            while (std::getline(stream, token, ',')) {
+            for (const auto& token : splitList(value)) {
                 auto trimmed = trimCopy(token);
                 if (!trimmed.empty()) {
                     names.push_back(std::move(trimmed));
@@ -130,11 +189,23 @@ namespace ipd {
             return Payoff(numbers[0], numbers[1], numbers[2], numbers[3]);
         }
 
+        std::pair<int, int> parseReplay(std::string_view value) {
+            const std::string text = trimCopy(value);
+            const auto comma = text.find(',');
+            if (comma == std::string::npos) {
+                exitWithError("error: '--replay' requires REPEAT,PAIR.");
+            }
+            const int repeat = parseNumber<int>(trimCopy(text.substr(0, comma)), "--replay");
+            const int pair = parseNumber<int>(trimCopy(text.substr(comma + 1)), "--replay");
+            if (repeat < 0 || pair < 0) {
+                exitWithError("error: '--replay' indices must be non-negative.");
+            }
+            return { repeat, pair };
+        }
+
         std::unordered_map<std::string, int> parseScbMap(std::string_view value) {
             std::unordered_map<std::string, int> costs;
-            std::stringstream stream{ std::string(value) };
-            std::string token;
-            while (std::getline(stream, token, ',')) {
+            for (const auto& token : splitList(value)) {
                 const std::string entry = trimCopy(token);
                 if (entry.empty()) {
                     continue;
@@ -225,6 +296,61 @@ namespace ipd {
             if (overrides.scbCosts) {
                 config.scbCosts = *overrides.scbCosts;
             }
+            if (overrides.threads) {
+                config.threads = *overrides.threads;
+            }
+            if (overrides.fitness) {
+                config.fitness = *overrides.fitness;
+            }
+            if (overrides.dynamics) {
+                config.dynamics = *overrides.dynamics;
+            }
+            if (overrides.integrator) {
+                config.integrator = *overrides.integrator;
+            }
+            if (overrides.timeStep) {
+                config.timeStep = *overrides.timeStep;
+            }
+            if (overrides.rngEngine) {
+                config.rngEngine = *overrides.rngEngine;
+            }
+            if (overrides.cycleSkip) {
+                config.cycleSkip = *overrides.cycleSkip;
+            }
+            if (overrides.matchCache) {
+                config.matchCache = *overrides.matchCache;
+            }
+            if (overrides.lockstep) {
+                config.lockstep = *overrides.lockstep;
+            }
+            if (overrides.exact) {
+                config.exact = *overrides.exact;
+            }
+            if (overrides.horizon) {
+                config.horizon = *overrides.horizon;
+            }
+            if (overrides.symmetric) {
+                config.symmetric = *overrides.symmetric;
+            }
+            if (overrides.matrix) {
+                config.matrix = *overrides.matrix;
+            }
+            if (overrides.landscape) {
+                config.landscape = *overrides.landscape;
+            }
+            if (overrides.ciTarget) {
+                config.ciTarget = *overrides.ciTarget;
+            }
+            if (overrides.maxRepeats) {
+                config.maxRepeats = *overrides.maxRepeats;
+            }
+            if (overrides.replay) {
+                config.replayRepeat = overrides.replay->first;
+                config.replayPair = overrides.replay->second;
+            }
+            if (overrides.benchmark) {
+                config.benchmark = *overrides.benchmark;
+            }
         }
 
         std::string escapeJson(std::string_view text) {
@@ -301,12 +427,13 @@ namespace ipd {
             return json.substr(valuePos, endPos - valuePos);
         }
 
-        std::optional<int> parseIntField(const std::string& json, std::string_view key) {
+        template <typename T = int>
+        std::optional<T> parseIntField(const std::string& json, std::string_view key) {
             const auto raw = extractRawValue(json, key);
             if (!raw) {
                 return std::nullopt;
             }
-            return parseNumber<int>(trimCopy(*raw), key);
+            return parseNumber<T>(trimCopy(*raw), key);
         }
 
         std::optional<double> parseDoubleField(const std::string& json, std::string_view key) {
@@ -350,10 +477,7 @@ namespace ipd {
                 exitWithError("error: invalid strategies array in JSON config.");
             }
             std::vector<std::string> strategies;
-            std::string content = raw->substr(1, raw->size() - 2);
-            std::stringstream stream{ content };
-            std::string token;
-            while (std::getline(stream, token, ',')) {
+            for (std::string token : splitList(std::string_view(*raw).substr(1, raw->size() - 2))) {
                 token = trimCopy(token);
                 if (token.size() >= 2 && token.front() == '"' && token.back() == '"') {
                     strategies.push_back(token.substr(1, token.size() - 2));
@@ -376,10 +500,7 @@ namespace ipd {
             exitWithError("error: invalid object for '" + std::string(key) + "'.");
         }
         std::unordered_map<std::string, int> costs;
-        std::string content = trimmed.substr(1, trimmed.size() - 2);
-        std::stringstream stream{ content };
-        std::string token;
-        while (std::getline(stream, token, ',')) {
+        for (const auto& token : splitList(std::string_view(trimmed).substr(1, trimmed.size() - 2))) {
             std::string entry = trimCopy(token);
             if (entry.empty()) {
                 continue;
@@ -412,6 +533,22 @@ namespace ipd {
             if (argument == "--help") {
                 printHelpAndExit();
             }
+            if (argument == "--benchmark") {
+                overrides.benchmark = true;
+                continue;
+            }
+            if (argument == "--matrix") {
+                overrides.matrix = true;
+                continue;
+            }
+            if (argument == "--exact") {
+                overrides.exact = true;
+                continue;
+            }
+            if (argument == "--symmetric") {
+                overrides.symmetric = true;
+                continue;
+            }
             if (argument == "--verbose") {
                 overrides.verbose = true;
                 continue;
@@ -456,6 +593,23 @@ namespace ipd {
                 overrides.repeats = parseNumber<int>(trimCopy(*value), "--repeats");
                 continue;
             }
+            if (auto value = matchOptionValue(argument, "--ci-target", index, argc, argv)) {
+                overrides.ciTarget = parseNumber<double>(trimCopy(*value), "--ci-target");
+                continue;
+            }
+            if (auto value = matchOptionValue(argument, "--landscape", index, argc, argv)) {
+                const int resolution = parseNumber<int>(trimCopy(*value), "--landscape");
+                if (resolution != 0 && (resolution < 2 || resolution > LandscapeScanner::kMaxResolution)) {
+                    exitWithError("error: '--landscape' needs 2 to " + std::to_string(LandscapeScanner::kMaxResolution)
+                        + " points per axis (0 disables it).");
+                }
+                overrides.landscape = resolution;
+                continue;
+            }
+            if (auto value = matchOptionValue(argument, "--max-repeats", index, argc, argv)) {
+                overrides.maxRepeats = parseNumber<int>(trimCopy(*value), "--max-repeats");
+                continue;
+            }
             if (auto value = matchOptionValue(argument, "--epsilon", index, argc, argv)) {
                 overrides.epsilon = parseNumber<double>(trimCopy(*value), "--epsilon");
                 continue;
@@ -464,6 +618,67 @@ namespace ipd {
                 overrides.seed = static_cast<unsigned int>(parseNumber<unsigned long>(trimCopy(*value), "--seed"));
                 continue;
             }
+            if (auto value = matchOptionValue(argument, "--threads", index, argc, argv)) {
+                overrides.threads = parseNumber<int>(trimCopy(*value), "--threads");
+                continue;
+            }
+            if (auto value = matchOptionValue(argument, "--rng", index, argc, argv)) {
+                std::string engine = trimCopy(*value);
+                std::transform(engine.begin(), engine.end(), engine.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+                if (engine != "philox" && engine != "xoshiro" && engine != "mt19937") {
+                    exitWithError("error: '--rng' must be one of philox, xoshiro, or mt19937.");
+                }
+                overrides.rngEngine = engine;
+                continue;
+            }
+            if (auto value = matchOptionValue(argument, "--horizon", index, argc, argv)) {
+                std::string horizon = trimCopy(*value);
+                std::transform(horizon.begin(), horizon.end(), horizon.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+                if (horizon != "finite" && horizon != "stationary") {
+                    exitWithError("error: '--horizon' must be one of finite or stationary.");
+                }
+                overrides.horizon = horizon;
+                continue;
+            }
+            if (auto value = matchOptionValue(argument, "--fitness", index, argc, argv)) {
+                std::string fitness = trimCopy(*value);
+                std::transform(fitness.begin(), fitness.end(), fitness.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+                if (fitness != "tournament" && fitness != "matrix") {
+                    exitWithError("error: '--fitness' must be one of tournament or matrix.");
+                }
+                overrides.fitness = fitness;
+                continue;
+            }
+            if (auto value = matchOptionValue(argument, "--dynamics", index, argc, argv)) {
+                std::string dynamics = trimCopy(*value);
+                std::transform(dynamics.begin(), dynamics.end(), dynamics.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+                if (dynamics != "wright-fisher" && dynamics != "replicator") {
+                    exitWithError("error: '--dynamics' must be one of wright-fisher or replicator.");
+                }
+                overrides.dynamics = dynamics;
+                continue;
+            }
+            if (auto value = matchOptionValue(argument, "--integrator", index, argc, argv)) {
+                std::string integrator = trimCopy(*value);
+                std::transform(integrator.begin(), integrator.end(), integrator.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+                if (integrator != "rk4" && integrator != "adaptive") {
+                    exitWithError("error: '--integrator' must be one of rk4 or adaptive.");
+                }
+                overrides.integrator = integrator;
+                continue;
+            }
+            if (auto value = matchOptionValue(argument, "--step", index, argc, argv)) {
+                const double step = parseNumber<double>(trimCopy(*value), "--step");
+                if (!(step > 0.0)) {
+                    exitWithError("error: '--step' must be positive.");
+                }
+                overrides.timeStep = step;
+                continue;
+            }
+            if (auto value = matchOptionValue(argument, "--replay", index, argc, argv)) {
+                overrides.replay = parseReplay(*value);
+                continue;
+            }
             if (auto value = matchOptionValue(argument, "--strategies", index, argc, argv)) {
                 overrides.strategies = parseStrategies(*value);
                 continue;
@@ -477,7 +692,7 @@ namespace ipd {
                 continue;
             }
             if (auto value = matchOptionValue(argument, "--population", index, argc, argv)) {
-                overrides.population = parseNumber<int>(trimCopy(*value), "--population");
+                overrides.population = parseNumber<std::int64_t>(trimCopy(*value), "--population");
                 continue;
             }
             if (auto value = matchOptionValue(argument, "--mutation", index, argc, argv)) {
@@ -491,8 +706,8 @@ namespace ipd {
             if (auto value = matchOptionValue(argument, "--format", index, argc, argv)) {
                 std::string format = trimCopy(*value);
                 std::transform(format.begin(), format.end(), format.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
-                if (format != "text" && format != "csv" && format != "json") {
-                    exitWithError("error: '--format' must be one of text, csv, or json.");
+                if (format != "text" && format != "csv" && format != "json" && format != "binary") {
+                    exitWithError("error: '--format' must be one of text, csv, json, or binary.");
                 }
                 overrides.format = format;
                 continue;
@@ -509,6 +724,30 @@ namespace ipd {
                 overrides.evolve = evolveFlag == 1;
                 continue;
             }
+            if (auto value = matchOptionValue(argument, "--cycle-skip", index, argc, argv)) {
+                const int cycleSkipFlag = parseNumber<int>(trimCopy(*value), "--cycle-skip");
+                if (cycleSkipFlag != 0 && cycleSkipFlag != 1) {
+                    exitWithError("error: '--cycle-skip' accepts only 0 or 1.");
+                }
+                overrides.cycleSkip = cycleSkipFlag == 1;
+                continue;
+            }
+            if (auto value = matchOptionValue(argument, "--match-cache", index, argc, argv)) {
+                const int matchCacheFlag = parseNumber<int>(trimCopy(*value), "--match-cache");
+                if (matchCacheFlag != 0 && matchCacheFlag != 1) {
+                    exitWithError("error: '--match-cache' accepts only 0 or 1.");
+                }
+                overrides.matchCache = matchCacheFlag == 1;
+                continue;
+            }
+            if (auto value = matchOptionValue(argument, "--lockstep", index, argc, argv)) {
+                const int lockstepFlag = parseNumber<int>(trimCopy(*value), "--lockstep");
+                if (lockstepFlag != 0 && lockstepFlag != 1) {
+                    exitWithError("error: '--lockstep' accepts only 0 or 1.");
+                }
+                overrides.lockstep = lockstepFlag == 1;
+                continue;
+            }
             if (auto value = matchOptionValue(argument, "--save", index, argc, argv)) {
                 overrides.saveFile = trimCopy(*value);
                 continue;
@@ -528,27 +767,55 @@ namespace ipd {
 
         applyOverrides(config, overrides);
         config.ensureDefaults();
+        if (config.landscape > LandscapeScanner::kMaxResolution) {
+            exitWithError("error: 'landscape' allows at most " + std::to_string(LandscapeScanner::kMaxResolution) + " points per axis.");
+        }
+        if (config.outputFormat == "binary" && ((!config.matrix && config.landscape == 0) || config.outputFile.empty())) {
+            exitWithError("error: '--format binary' writes the --matrix table or the --landscape grid and needs --output FILE.");
+        }
         return config;
     }
 
     void Config::ensureDefaults() {
         rounds = std::max(1, rounds);
         repeats = std::max(1, repeats);
+        ciTarget = std::max(0.0, ciTarget);
+        maxRepeats = std::max(repeats, maxRepeats);
         epsilon = std::clamp(epsilon, 0.0, 1.0);
-        populationSize = std::max(0, populationSize);
+        populationSize = std::max<std::int64_t>(0, populationSize);
         mutationRate = std::clamp(mutationRate, 0.0, 1.0);
         complexityPenalty = std::max(0.0, complexityPenalty);
+        threads = std::max(1, threads);
+        landscape = landscape < 2 ? 0 : landscape;
+        if (rngEngine != "philox" && rngEngine != "xoshiro" && rngEngine != "mt19937") {
+            rngEngine = "philox";
+        }
+        if (fitness != "tournament" && fitness != "matrix") {
+            fitness = "tournament";
+        }
+        if (horizon != "finite" && horizon != "stationary") {
+            horizon = "finite";
+        }
+        if (dynamics != "wright-fisher" && dynamics != "replicator") {
+            dynamics = "wright-fisher";
+        }
+        if (integrator != "rk4" && integrator != "adaptive") {
+            integrator = "rk4";
+        }
+        if (!(timeStep > 0.0)) {
+            timeStep = 0.1;
+        }
         std::transform(outputFormat.begin(), outputFormat.end(), outputFormat.begin(), [](unsigned char ch) {
             return static_cast<char>(std::tolower(ch));
             });
-        if (outputFormat != "text" && outputFormat != "csv" && outputFormat != "json") {
+        if (outputFormat != "text" && outputFormat != "csv" && outputFormat != "json" && outputFormat != "binary") {
             outputFormat = "text";
         }
         if (strategyNames.empty()) {
             strategyNames = { "ALLC", "ALLD", "TFT", "GRIM", "PAVLOV", "RND", "CTFT", "PROBER", "Empath", "Reflector" };
         }
         if (populationSize == 0 && generations > 0) {
-            populationSize = static_cast<int>(strategyNames.size());
+            populationSize = static_cast<std::int64_t>(strategyNames.size());
         }
         evolve = evolve || generations > 0;
     }
@@ -597,6 +864,10 @@ namespace ipd {
         stream << "  \"generations\": " << generations << ",\n";
         stream << "  \"population\": " << populationSize << ",\n";
         stream << "  \"mutation\": " << std::fixed << std::setprecision(6) << mutationRate << ",\n";
+        stream << "  \"fitness\": \"" << escapeJson(fitness) << "\",\n";
+        stream << "  \"dynamics\": \"" << escapeJson(dynamics) << "\",\n";
+        stream << "  \"integrator\": \"" << escapeJson(integrator) << "\",\n";
+        stream << "  \"step\": " << std::fixed << std::setprecision(6) << timeStep << ",\n";
         stream << "  \"complexity_penalty\": " << std::fixed << std::setprecision(6) << complexityPenalty << ",\n";
         stream << "  \"scb_enabled\": " << (scbEnabled ? "true" : "false") << ",\n";
         stream << "  \"scb_costs\": " << formattedScb << ",\n";
@@ -605,6 +876,18 @@ namespace ipd {
         stream << "  \"seed\": " << seed << ",\n";
         stream << "  \"use_seed\": " << (useSeed ? "true" : "false") << ",\n";
         stream << "  \"evolve\": " << (evolve ? "true" : "false") << ",\n";
+        stream << "  \"threads\": " << threads << ",\n";
+        stream << "  \"rng\": \"" << escapeJson(rngEngine) << "\",\n";
+        stream << "  \"cycle_skip\": " << (cycleSkip ? "true" : "false") << ",\n";
+        stream << "  \"match_cache\": " << (matchCache ? "true" : "false") << ",\n";
+        stream << "  \"lockstep\": " << (lockstep ? "true" : "false") << ",\n";
+        stream << "  \"exact\": " << (exact ? "true" : "false") << ",\n";
+        stream << "  \"horizon\": \"" << escapeJson(horizon) << "\",\n";
+        stream << "  \"symmetric\": " << (symmetric ? "true" : "false") << ",\n";
+        stream << "  \"matrix\": " << (matrix ? "true" : "false") << ",\n";
+        stream << "  \"landscape\": " << landscape << ",\n";
+        stream << "  \"ci_target\": " << ciTarget << ",\n";
+        stream << "  \"max_repeats\": " << maxRepeats << ",\n";
         stream << "  \"verbose\": " << (verbose ? "true" : "false") << '\n';
         stream << "}\n";
     }
@@ -634,7 +917,7 @@ namespace ipd {
         if (auto value = parseIntField(json, "generations")) {
             config.generations = *value;
         }
-        if (auto value = parseIntField(json, "population")) {
+        if (auto value = parseIntField<std::int64_t>(json, "population")) {
             config.populationSize = *value;
         }
         if (auto value = parseDoubleField(json, "mutation")) {
@@ -659,6 +942,54 @@ namespace ipd {
         if (auto value = parseBoolField(json, "evolve")) {
             config.evolve = *value;
         }
+        if (auto value = parseIntField(json, "threads")) {
+            config.threads = *value;
+        }
+        if (auto value = parseStringField(json, "fitness")) {
+            config.fitness = *value;
+        }
+        if (auto value = parseStringField(json, "dynamics")) {
+            config.dynamics = *value;
+        }
+        if (auto value = parseStringField(json, "integrator")) {
+            config.integrator = *value;
+        }
+        if (auto value = parseDoubleField(json, "step")) {
+            config.timeStep = *value;
+        }
+        if (auto value = parseStringField(json, "rng")) {
+            config.rngEngine = *value;
+        }
+        if (auto value = parseBoolField(json, "cycle_skip")) {
+            config.cycleSkip = *value;
+        }
+        if (auto value = parseBoolField(json, "match_cache")) {
+            config.matchCache = *value;
+        }
+        if (auto value = parseBoolField(json, "lockstep")) {
+            config.lockstep = *value;
+        }
+        if (auto value = parseBoolField(json, "exact")) {
+            config.exact = *value;
+        }
+        if (auto value = parseStringField(json, "horizon")) {
+            config.horizon = *value;
+        }
+        if (auto value = parseBoolField(json, "symmetric")) {
+            config.symmetric = *value;
+        }
+        if (auto value = parseBoolField(json, "matrix")) {
+            config.matrix = *value;
+        }
+        if (auto value = parseIntField(json, "landscape")) {
+            config.landscape = *value;
+        }
+        if (auto value = parseDoubleField(json, "ci_target")) {
+            config.ciTarget = *value;
+        }
+        if (auto value = parseIntField(json, "max_repeats")) {
+            config.maxRepeats = *value;
+        }
         if (auto value = parseBoolField(json, "verbose")) {
             config.verbose = *value;
         }
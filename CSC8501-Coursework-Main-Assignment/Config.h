@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
@@ -17,8 +18,12 @@ namespace ipd {
         Payoff payoffs;
         std::vector<std::string> strategyNames;
         int generations = 0;
-        int populationSize = 0;
+        std::int64_t populationSize = 0;
         double mutationRate = 0.0;
+        std::string fitness = "tournament"; // evolution fitness: "tournament" re-plays every generation, "matrix" reuses one payoff matrix
+        std::string dynamics = "wright-fisher"; // "wright-fisher" samples the population, "replicator" integrates shares
+        std::string integrator = "rk4";
+        double timeStep = 0.1; // replicator RK4 step (initial step for the adaptive integrator); one generation is one time unit
         double complexityPenalty = 0.0;
         std::string outputFormat = "text";
         std::string outputFile = "";
@@ -28,6 +33,21 @@ namespace ipd {
 		std::string loadFile;
         bool scbEnabled = false;
         std::unordered_map<std::string, int> scbCosts;
+        int threads = 1;
+        std::string rngEngine = "philox";
+        bool cycleSkip = true;
+        bool matchCache = true;
+        bool lockstep = true;
+        bool exact = false; // evaluate pairings of transition-table strategies as Markov chains instead of sampling
+        std::string horizon = "finite"; // exact totals over the match ("finite") or from the long-run mean ("stationary")
+        bool symmetric = false;
+        bool matrix = false; // report the row-vs-column payoff matrix instead of the league table
+        int landscape = 0; // memory-one grid points per axis to score against the field; 0 runs the tournament
+        double ciTarget = 0.0; // 0 plays exactly `repeats`
+        int maxRepeats = 1000;
+        int replayRepeat = -1;
+        int replayPair = -1;
+        bool benchmark = false; // time evolution sampling across population sizes instead of evolving
 
         static Config fromCommandLine(int argc, char** argv);
         void ensureDefaults();
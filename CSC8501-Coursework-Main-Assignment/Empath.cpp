@@ -3,6 +3,11 @@
 #include <algorithm>
 
 namespace ipd {
+    namespace {
+        constexpr Probability kRemorseCooperate(0.8);
+        constexpr Probability kPostRemorseCooperate(0.6);
+    }
+
     Empath::Empath()
         : m_remorseRemaining(0)
         , m_postRemorseBias(false) {
@@ -39,14 +44,14 @@ namespace ipd {
         }
 
         if (m_remorseRemaining > 0) {
-            const Move choice = rng.nextBool(0.8) ? Move::Cooperate : Move::Defect;
+            const Move choice = rng.nextBool(kRemorseCooperate) ? Move::Cooperate : Move::Defect;
             m_remorseRemaining = std::max(0, m_remorseRemaining - 1);
             return choice;
         }
 
         if (m_postRemorseBias) {
             m_postRemorseBias = false;
-            return rng.nextBool(0.6) ? Move::Cooperate : Move::Defect;
+            return rng.nextBool(kPostRemorseCooperate) ? Move::Cooperate : Move::Defect;
         }
 
         return opponentLast;
@@ -5,7 +5,7 @@
 #include "Strategy.h"
 
 namespace ipd {
-    class Empath : public Strategy {
+    class Empath final : public Strategy {
     public:
         Empath();
 
@@ -13,6 +13,7 @@ namespace ipd {
         Move nextMove(const MatchState& state, int selfIndex, Random& rng) override;
         void reset() override;
 		int complexity() const override { return 3; }
+        std::size_t historyDepth() const override { return 1; }
 
     private:
         int m_remorseRemaining;
@@ -10,6 +10,8 @@
 #include <stdexcept>
 #include <vector>
 
+#include "ReplicatorDynamics.h"
+#include "Timer.h"
 #include "TournamentManager.h"
 #include "StrategyFactory.h"
 
@@ -48,24 +50,86 @@ namespace ipd {
             return fitness;
         }
 
-        std::vector<int> initialCounts(const std::vector<std::string>& names, int population) {
-            const int n = static_cast<int>(names.size());
-            std::vector<int> counts(n, 0);
+        // Per-entry view of a tournament's payoff matrix, fixed for the whole run.
+        struct MatrixFitness {
+            PayoffMatrix matrix;
+            std::vector<std::size_t> rows; // matrix row of each config entry
+            std::vector<double> offsets;   // SCB cost plus complexity penalty of each entry
+        };
+
+        MatrixFitness makeMatrixFitness(
+            const std::vector<std::string>& names,
+            PayoffMatrix matrix,
+            const std::vector<Result>& results,
+            double penalty)
+        {
+            std::map<std::string, std::size_t> rowByName;
+            for (std::size_t row = 0; row < matrix.names.size(); ++row)
+                rowByName.emplace(matrix.names[row], row);
+            std::map<std::string, double> offsetByName;
+            for (const auto& r : results)
+                offsetByName[r.strategy] = r.mean - penalisedFitness(r, penalty);
+
+            MatrixFitness model;
+            model.rows.reserve(names.size());
+            model.offsets.reserve(names.size());
+            for (const auto& name : names) {
+                model.rows.push_back(rowByName.at(name));
+                model.offsets.push_back(offsetByName[name]);
+            }
+            model.matrix = std::move(matrix);
+            return model;
+        }
+
+        // Frequency-dependent fitness: the expected payoff against an opponent drawn from the
+        // rest of the current population (an extinct strategy faces the whole population).
+        std::vector<double> frequencyFitness(const MatrixFitness& model, const std::vector<PopulationCount>& counts) {
+            const std::size_t rows = model.matrix.names.size();
+            std::vector<double> rowCounts(rows, 0.0);
+            for (std::size_t i = 0; i < counts.size(); ++i)
+                rowCounts[model.rows[i]] += static_cast<double>(std::max<PopulationCount>(counts[i], 0));
+            const double population = std::accumulate(rowCounts.begin(), rowCounts.end(), 0.0);
+
+            std::vector<double> rowFitness(rows, 0.0);
+            for (std::size_t row = 0; row < rows; ++row) {
+                const double self = rowCounts[row] > 0.0 ? 1.0 : 0.0;
+                const double opponents = population - self;
+                if (opponents <= 0.0) {
+                    rowFitness[row] = model.matrix.at(row, row).mean;
+                    continue;
+                }
+                double payoff = 0.0;
+                for (std::size_t column = 0; column < rows; ++column) {
+                    const double others = rowCounts[column] - (column == row ? self : 0.0);
+                    payoff += model.matrix.at(row, column).mean * others;
+                }
+                rowFitness[row] = payoff / opponents;
+            }
+
+            std::vector<double> fitness(counts.size(), 0.0);
+            for (std::size_t i = 0; i < counts.size(); ++i)
+                fitness[i] = rowFitness[model.rows[i]] - model.offsets[i];
+            return fitness;
+        }
+
+        std::vector<PopulationCount> initialCounts(const std::vector<std::string>& names, PopulationCount population) {
+            const auto n = static_cast<PopulationCount>(names.size());
+            std::vector<PopulationCount> counts(names.size(), 0);
             if (n == 0 || population <= 0) return counts;
-            const int base = population / n;
-            int rem = population % n;
-            for (int i = 0; i < n; ++i) {
+            const PopulationCount base = population / n;
+            PopulationCount rem = population % n;
+            for (std::size_t i = 0; i < counts.size(); ++i) {
                 counts[i] = base + (rem > 0 ? 1 : 0);
                 if (rem > 0) --rem;
             }
             return counts;
         }
 
-        std::vector<std::pair<std::string, int>> toOrderedCounts(
+        std::vector<std::pair<std::string, PopulationCount>> toOrderedCounts(
             const std::vector<std::string>& names,
-            const std::vector<int>& counts)
+            const std::vector<PopulationCount>& counts)
         {
-            std::vector<std::pair<std::string, int>> ordered;
+            std::vector<std::pair<std::string, PopulationCount>> ordered;
             for (std::size_t i = 0; i < names.size(); ++i)
                 ordered.emplace_back(names[i], i < counts.size() ? counts[i] : 0);
             std::sort(ordered.begin(), ordered.end(),
@@ -76,14 +140,14 @@ namespace ipd {
         GenerationShare makeGenerationShare(
             int generation,
             const std::vector<std::string>& names,
-            const std::vector<int>& counts,
-            int population)
+            const std::vector<PopulationCount>& counts,
+            PopulationCount population)
         {
             GenerationShare g;
             g.generation = generation;
             g.counts = toOrderedCounts(names, counts);
             g.shares.reserve(g.counts.size());
-            const double total = static_cast<double>(std::max(population, 0));
+            const double total = static_cast<double>(std::max<PopulationCount>(population, 0));
             for (const auto& [name, cnt] : g.counts) {
                 const double ratio = (total > 0.0)
                     ? static_cast<double>(cnt) / total
@@ -93,10 +157,32 @@ namespace ipd {
             return g;
         }
 
+        // History entry for continuous shares; counts are the shares scaled to the population.
+        GenerationShare makeShareGeneration(
+            int generation,
+            const std::vector<std::string>& names,
+            const std::vector<double>& shares,
+            PopulationCount population)
+        {
+            std::vector<PopulationCount> counts(shares.size(), 0);
+            for (std::size_t i = 0; i < shares.size(); ++i)
+                counts[i] = std::llround(shares[i] * static_cast<double>(std::max<PopulationCount>(population, 0)));
+
+            GenerationShare g;
+            g.generation = generation;
+            g.counts = toOrderedCounts(names, counts);
+            g.shares.reserve(names.size());
+            for (std::size_t i = 0; i < names.size(); ++i)
+                g.shares.emplace_back(names[i], shares[i]);
+            std::sort(g.shares.begin(), g.shares.end(),
+                [](auto& a, auto& b) { return a.first < b.first; });
+            return g;
+        }
+
         double shareForStrategy(
             const std::vector<std::string>& names,
-            const std::vector<int>& counts,
-            int population,
+            const std::vector<PopulationCount>& counts,
+            PopulationCount population,
             const std::string& strategy)
         {
             if (population <= 0) return 0.0;
@@ -107,7 +193,7 @@ namespace ipd {
         }
 
         std::vector<double> computeProbabilities(
-            const std::vector<int>& counts,
+            const std::vector<PopulationCount>& counts,
             const std::vector<double>& fitness)
         {
             const std::size_t n = counts.size();
@@ -120,14 +206,14 @@ namespace ipd {
             double total = 0.0;
             for (std::size_t i = 0; i < n; ++i) {
                 const double shifted = std::max((i < fitness.size() ? fitness[i] : 0.0) - minFit + kEpsilon, kEpsilon);
-                const double w = shifted * static_cast<double>(std::max(counts[i], 0));
+                const double w = shifted * static_cast<double>(std::max<PopulationCount>(counts[i], 0));
                 weights[i] = w;
                 total += w;
             }
 
             if (total <= 0.0) {
                 for (std::size_t i = 0; i < n; ++i)
-                    weights[i] = static_cast<double>(std::max(counts[i], 0));
+                    weights[i] = static_cast<double>(std::max<PopulationCount>(counts[i], 0));
                 total = std::accumulate(weights.begin(), weights.end(), 0.0);
                 if (total <= 0.0)
                     return std::vector<double>(n, 1.0 / static_cast<double>(n));
@@ -141,23 +227,33 @@ namespace ipd {
 
     EvolutionManager::EvolutionManager() : m_random() {}
 
-    std::vector<int> EvolutionManager::sampleNextGeneration(
-        const std::vector<double>& probabilities, int population)
+    // Multinomial draw as a chain of binomials: each strategy takes its conditional share of
+    // the individuals not yet assigned, so the cost is O(strategies) whatever the population.
+    std::vector<PopulationCount> EvolutionManager::sampleNextGeneration(
+        const std::vector<double>& probabilities, PopulationCount population)
     {
         const std::size_t n = probabilities.size();
-        std::vector<int> counts(n, 0);
+        std::vector<PopulationCount> counts(n, 0);
         if (n == 0 || population <= 0) return counts;
 
-        std::discrete_distribution<int> dist(probabilities.begin(), probabilities.end());
-        for (int i = 0; i < population; ++i) {
-            int idx = dist(m_random.engine());
-            ++counts[idx];
+        PopulationCount remaining = population;
+        double remainingMass = std::accumulate(probabilities.begin(), probabilities.end(), 0.0);
+        for (std::size_t i = 0; i < n && remaining > 0; ++i) {
+            const double p = std::max(probabilities[i], 0.0);
+            if (i + 1 == n || p >= remainingMass) {
+                counts[i] = remaining;
+                break;
+            }
+            std::binomial_distribution<PopulationCount> draw(remaining, std::clamp(p / remainingMass, 0.0, 1.0));
+            counts[i] = draw(m_random);
+            remaining -= counts[i];
+            remainingMass -= p;
         }
         return counts;
     }
 
     void EvolutionManager::mutateCounts(
-        std::vector<int>& counts,
+        std::vector<PopulationCount>& counts,
         double mutationRate,
         const std::vector<double>& probabilities)
     {
@@ -165,17 +261,30 @@ namespace ipd {
         const std::size_t n = counts.size();
         if (n <= 1 || mutationRate <= 0.0) return;
 
+        // round(count * rate) individuals leave each strategy and spread uniformly over the
+        // others (a binomial chain per source). Flows come from the pre-mutation counts, so an
+        // individual mutates at most once per generation.
+        std::vector<PopulationCount> inflow(n, 0);
         for (std::size_t i = 0; i < n; ++i) {
-            int c = counts[i];
+            const PopulationCount c = counts[i];
             if (c <= 0) continue;
-            int m = static_cast<int>(std::round(static_cast<double>(c) * mutationRate));
-            for (int k = 0; k < m; ++k) {
-                int target;
-                do { target = m_random.nextInt(0, (int)n - 1); } while (target == (int)i);
-                --counts[i];
-                ++counts[target];
+            PopulationCount remaining = std::llround(static_cast<double>(c) * mutationRate);
+            counts[i] -= remaining;
+            std::size_t targetsLeft = n - 1;
+            for (std::size_t target = 0; target < n && remaining > 0; ++target) {
+                if (target == i) continue;
+                PopulationCount moved = remaining;
+                if (targetsLeft > 1) {
+                    std::binomial_distribution<PopulationCount> draw(remaining, 1.0 / static_cast<double>(targetsLeft));
+                    moved = draw(m_random);
+                }
+                inflow[target] += moved;
+                remaining -= moved;
+                --targetsLeft;
             }
         }
+        for (std::size_t i = 0; i < n; ++i)
+            counts[i] += inflow[i];
     }
 
     EvolutionOutcome EvolutionManager::run(const Config& config) {
@@ -185,23 +294,39 @@ namespace ipd {
         registerBuiltinStrategies();
         const std::size_t n = config.strategyNames.size();
         if (n == 0) return out;
+        if (config.dynamics == "replicator") return runReplicator(config);
 
-        const int population = std::max(config.populationSize, 0);
-        std::vector<int> counts = initialCounts(config.strategyNames, population);
+        const PopulationCount population = std::max<PopulationCount>(config.populationSize, 0);
+        std::vector<PopulationCount> counts = initialCounts(config.strategyNames, population);
 
         TournamentManager tm;
         std::vector<Result> lastFitness;
         const Config evalCfg = makeEvaluationConfig(config);
 
+        // Matrix fitness plays the tournament once; each generation then only weights the
+        // pair payoffs by the current counts instead of re-playing every match.
+        const bool matrixFitness = config.fitness == "matrix";
+        MatrixFitness model;
+        if (matrixFitness) {
+            PayoffMatrix matrix;
+            lastFitness = tm.run(evalCfg, matrix);
+            model = makeMatrixFitness(config.strategyNames, std::move(matrix), lastFitness, config.complexityPenalty);
+        }
+
         out.history.push_back(makeGenerationShare(0, config.strategyNames, counts, population));
 
         for (int gen = 0; gen < config.generations; ++gen) {
-            lastFitness = tm.run(evalCfg);
-
-            const auto fitness = collectFitness(config.strategyNames, lastFitness, config.complexityPenalty);
+            std::vector<double> fitness;
+            if (matrixFitness) {
+                fitness = frequencyFitness(model, counts);
+            }
+            else {
+                lastFitness = tm.run(evalCfg);
+                fitness = collectFitness(config.strategyNames, lastFitness, config.complexityPenalty);
+            }
             const auto probs = computeProbabilities(counts, fitness);
 
-            std::vector<int> nextCounts = sampleNextGeneration(probs, population);
+            std::vector<PopulationCount> nextCounts = sampleNextGeneration(probs, population);
             mutateCounts(nextCounts, config.mutationRate, probs);
 
             counts = std::move(nextCounts);
@@ -216,6 +341,68 @@ namespace ipd {
         return out;
     }
 
+    // Noise-free counterpart of the sampled loop: shares follow the replicator equation on the
+    // tournament's payoff matrix, one generation per time unit.
+    EvolutionOutcome EvolutionManager::runReplicator(const Config& config) {
+        EvolutionOutcome out;
+        const std::vector<std::string>& names = config.strategyNames;
+        const std::size_t n = names.size();
+        const PopulationCount population = std::max<PopulationCount>(config.populationSize, 0);
+
+        TournamentManager tm;
+        PayoffMatrix matrix;
+        std::vector<Result> results = tm.run(makeEvaluationConfig(config), matrix);
+        const MatrixFitness model = makeMatrixFitness(names, std::move(matrix), results, config.complexityPenalty);
+
+        std::vector<double> payoffs(n * n, 0.0);
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+                payoffs[i * n + j] = model.matrix.at(model.rows[i], model.rows[j]).mean;
+        ReplicatorDynamics dynamics(std::move(payoffs), model.offsets, config.mutationRate,
+            integratorFromName(config.integrator), config.timeStep);
+
+        std::vector<double> shares(n, 1.0 / static_cast<double>(n));
+        out.history.push_back(makeShareGeneration(0, names, shares, population));
+        for (int gen = 0; gen < config.generations; ++gen) {
+            dynamics.advance(shares, 1.0);
+            out.history.push_back(makeShareGeneration(gen + 1, names, shares, population));
+        }
+
+        for (auto& r : results) {
+            r.extra = 0.0;
+            for (std::size_t i = 0; i < n; ++i)
+                if (names[i] == r.strategy)
+                    r.extra += shares[i];
+        }
+        out.results = std::move(results);
+        return out;
+    }
+
+    std::vector<SamplingBenchmark> EvolutionManager::benchmark(const Config& config) {
+        registerBuiltinStrategies();
+        const std::vector<std::string>& names = config.strategyNames;
+        const int generations = config.generations > 0 ? config.generations : 1000;
+
+        TournamentManager tm;
+        PayoffMatrix matrix;
+        const std::vector<Result> results = tm.run(makeEvaluationConfig(config), matrix);
+        const MatrixFitness model = makeMatrixFitness(names, std::move(matrix), results, config.complexityPenalty);
+
+        std::vector<SamplingBenchmark> rows;
+        for (PopulationCount population = 1000; population <= 1000000000; population *= 100) {
+            std::vector<PopulationCount> counts = initialCounts(names, population);
+            Timer timer;
+            for (int gen = 0; gen < generations; ++gen) {
+                const auto probs = computeProbabilities(counts, frequencyFitness(model, counts));
+                std::vector<PopulationCount> nextCounts = sampleNextGeneration(probs, population);
+                mutateCounts(nextCounts, config.mutationRate, probs);
+                counts = std::move(nextCounts);
+            }
+            rows.push_back(SamplingBenchmark{ population, generations, timer.elapsedSeconds() / static_cast<double>(generations) });
+        }
+        return rows;
+    }
+
     void writeEvolutionSharesCsv(const Config& config, const std::vector<GenerationShare>& history) {
         if (history.empty()) return;
 
@@ -233,7 +420,7 @@ namespace ipd {
 
         os << "generation,strategy,count,share\n";
         for (const auto& g : history) {
-            std::map<std::string, int> countLookup;
+            std::map<std::string, PopulationCount> countLookup;
             for (const auto& kv : g.counts)
                 countLookup[kv.first] = kv.second;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -10,10 +11,12 @@
 
 namespace ipd {
 
+    using PopulationCount = std::int64_t;
+
     struct GenerationShare {
         int generation = 0;
         std::vector<std::pair<std::string, double>> shares;
-        std::vector<std::pair<std::string, int>> counts;
+        std::vector<std::pair<std::string, PopulationCount>> counts;
     };
 
     struct EvolutionOutcome {
@@ -21,21 +24,31 @@ namespace ipd {
         std::vector<GenerationShare> history;
     };
 
+    struct SamplingBenchmark {
+        PopulationCount population = 0;
+        int generations = 0;
+        double secondsPerGeneration = 0.0;
+    };
+
     class EvolutionManager {
     public:
         EvolutionManager();
 
         EvolutionOutcome run(const Config& config);
+        // Times the sampling loop (matrix fitness, selection, mutation) at growing population sizes.
+        std::vector<SamplingBenchmark> benchmark(const Config& config);
 
     private:
         Random m_random; 
 
-        std::vector<int> sampleNextGeneration(
+        EvolutionOutcome runReplicator(const Config& config);
+
+        std::vector<PopulationCount> sampleNextGeneration(
             const std::vector<double>& probabilities,
-            int population);
+            PopulationCount population);
 
         void mutateCounts(
-            std::vector<int>& counts,
+            std::vector<PopulationCount>& counts,
             double mutationRate,
             const std::vector<double>& probabilities);
     };
@@ -0,0 +1,12 @@
+#pragma once
+
+// Include in translation units whose arithmetic must round exactly like another code path.
+// It stops the compiler fusing a multiply and an add into one FMA (GCC does so by default
+// whenever the target has FMA, intrinsics included), which rounds once instead of twice.
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
\ No newline at end of file
@@ -26,4 +26,21 @@ namespace ipd {
     int GRIM::complexity() const {
         return 2;
     }
+
+    std::size_t GRIM::historyDepth() const {
+        return 1;
+    }
+
+    bool GRIM::isDeterministic() const {
+        return true;
+    }
+
+    std::optional<std::uint64_t> GRIM::stateSnapshot() const {
+        return m_triggered ? 1u : 0u;
+    }
+
+    // State 1: triggered.
+    std::optional<TransitionTable> GRIM::transitionTable() const {
+        return TransitionTable{ { 1.0, 0.0 }, { { 0, 1, 0, 1 }, { 1, 1, 1, 1 } } };
+    }
 }
\ No newline at end of file
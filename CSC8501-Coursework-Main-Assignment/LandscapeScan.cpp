@@ -0,0 +1,168 @@
+#include "LandscapeScan.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "Logger.h"
+#include "MEM1.h"
+#include "MarkovMatch.h"
+#include "Match.h"
+#include "Random.h"
+#include "StrategyFactory.h"
+#include "ThreadPool.h"
+
+namespace ipd {
+    namespace {
+        // A distinct field strategy; repeated names are scored once per point and weighted by
+        // how often they appear.
+        struct FieldMember {
+            std::string name;
+            std::size_t count = 0;
+            std::optional<TransitionTable> table;
+            bool deterministic = false;
+        };
+
+        std::vector<FieldMember> buildField(const std::vector<std::string>& names) {
+            const StrategyFactory& factory = StrategyFactory::instance();
+            std::vector<FieldMember> members;
+            std::unordered_map<std::string, std::size_t> ids;
+            for (const auto& name : names) {
+                const auto [entry, inserted] = ids.emplace(name, members.size());
+                if (inserted) {
+                    const StrategyPtr strategy = factory.create(name);
+                    members.push_back(FieldMember{ name, 0, strategy->transitionTable(), strategy->isDeterministic() });
+                }
+                ++members[entry->second].count;
+            }
+            return members;
+        }
+
+        // Every grid point shares one SCB cost: an explicit "MEM1" entry, else MEM1's complexity.
+        double scbCost(const Config& config) {
+            if (!config.scbEnabled) {
+                return 0.0;
+            }
+            auto it = config.scbCosts.find("MEM1");
+            if (it != config.scbCosts.end()) {
+                return static_cast<double>(it->second);
+            }
+            return static_cast<double>(MEM1({ 1.0, 1.0, 1.0, 1.0 }).complexity());
+        }
+
+        std::array<double, 4> gridPoint(std::size_t index, int resolution) {
+            const std::size_t axis = static_cast<std::size_t>(resolution);
+            std::array<double, 4> cooperate{};
+            for (std::size_t outcome = cooperate.size(); outcome-- > 0;) {
+                cooperate[outcome] = static_cast<double>(index % axis) / static_cast<double>(resolution - 1);
+                index /= axis;
+            }
+            return cooperate;
+        }
+
+        // Per-worker state: Match::play reuses its MatchState, and sampled opponents keep their
+        // own match state, so neither is shared between threads.
+        struct ScanWorker {
+            Match match;
+            std::vector<StrategyPtr> opponents; // null for members scored from their table
+        };
+    }
+
+    Landscape LandscapeScanner::run(const Config& config) const {
+        registerBuiltinStrategies();
+
+        Landscape landscape;
+        landscape.resolution = config.landscape;
+        landscape.field = config.strategyNames;
+        landscape.repeats = config.repeats;
+        if (config.landscape < 2 || config.strategyNames.empty()) {
+            return landscape;
+        }
+        if (config.landscape > kMaxResolution) {
+            throw std::runtime_error("Landscape resolution " + std::to_string(config.landscape) + " exceeds the maximum of "
+                + std::to_string(kMaxResolution) + " points per axis.");
+        }
+
+        Random seeder;
+        if (config.useSeed) {
+            seeder.reseed(config.seed);
+        }
+        const RandomEngine engine = randomEngineFromName(config.rngEngine);
+        const unsigned int baseSeed = config.useSeed ? config.seed : static_cast<unsigned int>(seeder());
+        const ExactHorizon horizon = exactHorizonFromName(config.horizon);
+        const double cost = scbCost(config);
+
+        const std::vector<FieldMember> members = buildField(config.strategyNames);
+        const double fieldSize = static_cast<double>(config.strategyNames.size());
+        const auto rounds = static_cast<double>(config.rounds);
+        const StrategyFactory& factory = StrategyFactory::instance();
+
+        const std::size_t axis = static_cast<std::size_t>(config.landscape);
+        const std::size_t pointCount = axis * axis * axis * axis;
+        landscape.points.resize(pointCount);
+
+        const std::size_t workerCount = std::min<std::size_t>(static_cast<std::size_t>(std::max(1, config.threads)), pointCount);
+        std::vector<ScanWorker> workers;
+        workers.reserve(workerCount);
+        for (std::size_t worker = 0; worker < workerCount; ++worker) {
+            ScanWorker context{ Match(config.payoffs, config.epsilon), {} };
+            context.match.setCycleSkip(config.cycleSkip);
+            for (const auto& member : members) {
+                context.opponents.push_back(member.table ? nullptr : factory.create(member.name));
+            }
+            workers.push_back(std::move(context));
+        }
+
+        // Contiguous slices: neighbouring points cost about the same, so the split stays even.
+        const std::size_t slice = (pointCount + workerCount - 1) / workerCount;
+        auto scan = [&](std::size_t workerIndex) {
+            ScanWorker& context = workers[workerIndex];
+            const std::size_t begin = workerIndex * slice;
+            const std::size_t end = std::min(pointCount, begin + slice);
+            for (std::size_t pointIndex = begin; pointIndex < end; ++pointIndex) {
+                LandscapePoint& point = landscape.points[pointIndex];
+                point.cooperate = gridPoint(pointIndex, config.landscape);
+                MEM1 player(point.cooperate);
+                const TransitionTable table = *player.transitionTable();
+
+                double total = 0.0;
+                for (std::size_t memberIndex = 0; memberIndex < members.size(); ++memberIndex) {
+                    const FieldMember& member = members[memberIndex];
+                    double score = 0.0;
+                    if (member.table) {
+                        score = expectedMatch(table, *member.table, config.payoffs, config.epsilon, config.rounds, horizon).scoreFirst;
+                    }
+                    else {
+                        // Noise-free pairs of deterministic players repeat the same match.
+                        const int repeats = config.epsilon <= 0.0 && player.isDeterministic() && member.deterministic ? 1 : config.repeats;
+                        for (int repeat = 0; repeat < repeats; ++repeat) {
+                            Random rngFirst = Random::stream(baseSeed, static_cast<std::uint32_t>(repeat), static_cast<std::uint32_t>(pointIndex),
+                                static_cast<std::uint32_t>(2 * memberIndex), engine);
+                            Random rngSecond = Random::stream(baseSeed, static_cast<std::uint32_t>(repeat), static_cast<std::uint32_t>(pointIndex),
+                                static_cast<std::uint32_t>(2 * memberIndex + 1), engine);
+                            score += context.match.play(player, *context.opponents[memberIndex], config.rounds, rngFirst, rngSecond).scoreFirst;
+                        }
+                        score /= static_cast<double>(repeats);
+                    }
+                    total += score / rounds * static_cast<double>(member.count);
+                }
+                point.mean = total / fieldSize;
+                point.net = point.mean - cost;
+            }
+        };
+
+        if (workerCount == 1) {
+            scan(0);
+        }
+        else {
+            ThreadPool pool(workerCount);
+            pool.run(scan);
+        }
+        logInfo("landscape: " + std::to_string(pointCount) + " MEM1 points against " + std::to_string(config.strategyNames.size())
+            + " field entries on " + std::to_string(workerCount) + " thread(s)");
+        return landscape;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "Config.h"
+
+namespace ipd {
+    // One memory-one strategy MEM1(pCC,pCD,pDC,pDD) and its mean per-round score against the
+    // field, in the same units as the league table and payoff matrix.
+    struct LandscapePoint {
+        std::array<double, 4> cooperate{};
+        double mean = 0.0;
+        double net = 0.0; // mean less the MEM1 SCB cost when SCB is enabled
+    };
+
+    // Scores over a regular grid with `resolution` values k / (resolution - 1) per probability,
+    // row-major with pCC varying slowest.
+    struct Landscape {
+        int resolution = 0;
+        std::vector<std::string> field; // config.strategyNames, duplicates included
+        int repeats = 0;                // matches sampled per field entry that has no transition table
+        std::vector<LandscapePoint> points;
+    };
+
+    // Scores every grid point against each field entry in one process, split across
+    // config.threads workers. Entries that export a transition table are evaluated exactly
+    // (config.horizon applies); the others are sampled over config.repeats matches on per-match
+    // streams, so results depend only on the seed, not on the thread count.
+    class LandscapeScanner {
+    public:
+        // 64^4 = 2^24 points (about 0.8 GB of results): far inside the 2^32 per-point stream
+        // keys and the size_t point count.
+        static constexpr int kMaxResolution = 64;
+
+        Landscape run(const Config& config) const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,313 @@
+#include "LockstepKernel.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+
+#include "BuiltinStrategies.h"
+
+namespace ipd {
+    namespace {
+        // 64 independent counters stored bit-sliced: plane k holds bit k of every lane's count,
+        // so adding a lane mask is a ripple carry that usually stops after a plane or two.
+        class LaneCounters {
+        public:
+            void add(std::uint64_t lanes) {
+                for (std::size_t plane = 0; lanes != 0 && plane < m_planes.size(); ++plane) {
+                    const std::uint64_t carry = m_planes[plane] & lanes;
+                    m_planes[plane] ^= lanes;
+                    lanes = carry;
+                }
+            }
+
+            std::size_t lane(std::size_t index) const {
+                std::size_t count = 0;
+                for (std::size_t plane = 0; plane < m_planes.size(); ++plane) {
+                    count |= static_cast<std::size_t>((m_planes[plane] >> index) & 1u) << plane;
+                }
+                return count;
+            }
+
+        private:
+            std::array<std::uint64_t, 32> m_planes{}; // rounds are an int, so counts fit in 32 bits
+        };
+
+        // One round of `Kind` in every lane; a set bit means Defect. `state` is the strategy's
+        // one bit (GRIM's trigger, PAVLOV's intended move, CTFT's contrition) and lastSelf /
+        // lastOpponent are the recorded moves. Before the first round all three are zero, which
+        // makes every strategy open exactly as its nextMove does on an empty history.
+        template <LockstepKind Kind>
+        std::uint64_t step(std::uint64_t& state, std::uint64_t lastSelf, std::uint64_t lastOpponent) {
+            if constexpr (Kind == LockstepKind::ALLC) {
+                return 0;
+            }
+            else if constexpr (Kind == LockstepKind::ALLD) {
+                return ~static_cast<std::uint64_t>(0);
+            }
+            else if constexpr (Kind == LockstepKind::TFT) {
+                return lastOpponent;
+            }
+            else if constexpr (Kind == LockstepKind::GRIM) {
+                state |= lastOpponent;
+                return state;
+            }
+            else if constexpr (Kind == LockstepKind::PAVLOV) {
+                state ^= lastSelf ^ lastOpponent;
+                return state;
+            }
+            else {
+                // Contrite: cooperate, staying contrite until the opponent cooperates. Otherwise
+                // become contrite after an own defection the opponent answered with cooperation.
+                const std::uint64_t move = ~state & lastOpponent;
+                state = (state & lastOpponent) | (~state & lastSelf & ~lastOpponent);
+                return move;
+            }
+        }
+
+        // Records the round (1-based) of each lane's first defection.
+        void noteFirstDefections(std::uint64_t moves, std::uint64_t& defected, int round, std::array<int, LockstepKernel::kLanes>& firstDefection) {
+            std::uint64_t fresh = moves & ~defected;
+            defected |= moves;
+            while (fresh != 0) {
+                std::size_t lane = 0;
+                while (((fresh >> lane) & 1u) == 0) {
+                    ++lane;
+                }
+                firstDefection[lane] = round + 1;
+                fresh &= fresh - 1;
+            }
+        }
+
+        // Each lane's noise flips, drawn as the match advances in Match::play's order: the first
+        // gap up front, then each flip's successor right after that round's move (after any draw
+        // the move itself made). Each lane keeps the round of its next flip, so memory stays
+        // constant in the round count and rounds before the earliest flip skip the lane loop.
+        class NoiseFlips {
+        public:
+            NoiseFlips(std::vector<Random>& streams, const Probability* noise)
+                : m_streams(streams), m_noise(noise) {
+                if (m_noise != nullptr) {
+                    for (std::size_t lane = 0; lane < streams.size(); ++lane) {
+                        m_nextFlip[lane] = streams[lane].nextGap(*m_noise);
+                        m_soonest = std::min(m_soonest, m_nextFlip[lane]);
+                    }
+                }
+            }
+
+            // Lanes whose move is flipped in `round`.
+            std::uint64_t take(int round) {
+                const auto current = static_cast<std::uint64_t>(round);
+                if (current != m_soonest) {
+                    return 0;
+                }
+                std::uint64_t flips = 0;
+                m_soonest = kNever;
+                for (std::size_t lane = 0; lane < m_streams.size(); ++lane) {
+                    if (m_nextFlip[lane] == current) {
+                        flips |= static_cast<std::uint64_t>(1) << lane;
+                        const std::uint64_t gap = m_streams[lane].nextGap(*m_noise);
+                        m_nextFlip[lane] = gap < kNever - current - 1 ? current + 1 + gap : kNever;
+                    }
+                    m_soonest = std::min(m_soonest, m_nextFlip[lane]);
+                }
+                return flips;
+            }
+
+        private:
+            static constexpr std::uint64_t kNever = ~static_cast<std::uint64_t>(0);
+
+            std::vector<Random>& m_streams;
+            const Probability* m_noise;
+            std::array<std::uint64_t, LockstepKernel::kLanes> m_nextFlip{};
+            std::uint64_t m_soonest = kNever;
+        };
+
+        // A seat yields one player's moves for every lane, round by round. A bit-state built-in
+        // never draws for its moves, so its stream only feeds the noise flips.
+        template <LockstepKind Kind>
+        class FsmSeat {
+        public:
+            FsmSeat(std::vector<Random>& streams, const Probability* noise)
+                : m_flips(streams, noise) {
+            }
+
+            std::uint64_t move(int round, std::uint64_t lastSelf, std::uint64_t lastOpponent) {
+                return step<Kind>(m_state, lastSelf, lastOpponent) ^ m_flips.take(round);
+            }
+
+        private:
+            NoiseFlips m_flips;
+            std::uint64_t m_state = 0;
+        };
+
+        // Reflector draws its move every round, so its noise gaps are drawn in between.
+        class ReflectorSeat {
+        public:
+            ReflectorSeat(ReflectorBatch& batch, std::vector<Random>& streams, const Probability* noise)
+                : m_batch(batch), m_streams(streams), m_flips(streams, noise) {
+                m_batch.reset(streams.size());
+            }
+
+            std::uint64_t move(int round, std::uint64_t lastSelf, std::uint64_t lastOpponent) {
+                if (round > 0) {
+                    m_batch.observe(lastSelf, lastOpponent);
+                }
+                const std::uint64_t moves = m_batch.decide(m_streams);
+                return moves ^ m_flips.take(round);
+            }
+
+        private:
+            ReflectorBatch& m_batch;
+            std::vector<Random>& m_streams;
+            NoiseFlips m_flips;
+        };
+
+        // Builds the seat for `kind` and hands it to `visit`, so each pairing of kinds gets its
+        // own instantiation of the round loop.
+        template <typename Visitor>
+        void withSeat(LockstepKind kind, ReflectorBatch& batch, std::vector<Random>& streams, const Probability* noise, Visitor&& visit) {
+            switch (kind) {
+            case LockstepKind::ALLC: { FsmSeat<LockstepKind::ALLC> seat(streams, noise); visit(seat); break; }
+            case LockstepKind::ALLD: { FsmSeat<LockstepKind::ALLD> seat(streams, noise); visit(seat); break; }
+            case LockstepKind::TFT: { FsmSeat<LockstepKind::TFT> seat(streams, noise); visit(seat); break; }
+            case LockstepKind::GRIM: { FsmSeat<LockstepKind::GRIM> seat(streams, noise); visit(seat); break; }
+            case LockstepKind::PAVLOV: { FsmSeat<LockstepKind::PAVLOV> seat(streams, noise); visit(seat); break; }
+            case LockstepKind::CTFT: { FsmSeat<LockstepKind::CTFT> seat(streams, noise); visit(seat); break; }
+            case LockstepKind::REFLECTOR: { ReflectorSeat seat(batch, streams, noise); visit(seat); break; }
+            }
+        }
+
+        // Plays every lane of one pairing to the end and fills one report per lane.
+        template <typename FirstSeat, typename SecondSeat>
+        void playLanes(FirstSeat& seatFirst, SecondSeat& seatSecond, int rounds, std::size_t lanes, const Payoff& payoff, std::vector<MatchReport>& reports) {
+            std::uint64_t lastFirst = 0;
+            std::uint64_t lastSecond = 0;
+
+            LaneCounters mutualCooperation;
+            LaneCounters suckerFirst;  // first cooperated, second defected
+            LaneCounters suckerSecond; // second cooperated, first defected
+            std::uint64_t defectedFirst = 0;
+            std::uint64_t defectedSecond = 0;
+            std::array<int, LockstepKernel::kLanes> firstDefectionFirst{};
+            std::array<int, LockstepKernel::kLanes> firstDefectionSecond{};
+
+            // Echo tracking only looks at mutual cooperation, so both players share it. Every round
+            // spent inside an echo adds one to the echo length sum; the closing round ends a sample.
+            LaneCounters echoRounds;
+            LaneCounters echoCloses;
+            std::uint64_t inEcho = 0;
+            std::uint64_t lastMutualCoop = ~static_cast<std::uint64_t>(0);
+
+            for (int round = 0; round < rounds; ++round) {
+                const std::uint64_t moveFirst = seatFirst.move(round, lastFirst, lastSecond);
+                const std::uint64_t moveSecond = seatSecond.move(round, lastSecond, lastFirst);
+
+                const std::uint64_t mutualCoop = ~moveFirst & ~moveSecond;
+                mutualCooperation.add(mutualCoop);
+                suckerFirst.add(~moveFirst & moveSecond);
+                suckerSecond.add(moveFirst & ~moveSecond);
+                if ((moveFirst & ~defectedFirst) != 0) {
+                    noteFirstDefections(moveFirst, defectedFirst, round, firstDefectionFirst);
+                }
+                if ((moveSecond & ~defectedSecond) != 0) {
+                    noteFirstDefections(moveSecond, defectedSecond, round, firstDefectionSecond);
+                }
+
+                const std::uint64_t echoActive = inEcho | (lastMutualCoop & ~mutualCoop);
+                echoRounds.add(echoActive);
+                echoCloses.add(echoActive & mutualCoop);
+                inEcho = echoActive & ~mutualCoop;
+                lastMutualCoop = mutualCoop;
+
+                lastFirst = moveFirst;
+                lastSecond = moveSecond;
+            }
+
+            reports.resize(lanes);
+            const auto totalRounds = static_cast<std::size_t>(rounds);
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                const std::size_t cc = mutualCooperation.lane(lane);
+                const std::size_t cd = suckerFirst.lane(lane);
+                const std::size_t dc = suckerSecond.lane(lane);
+                const std::size_t dd = totalRounds - cc - cd - dc;
+                const std::size_t echoSamples = echoCloses.lane(lane) + static_cast<std::size_t>((inEcho >> lane) & 1u);
+                const auto echoLengthSum = static_cast<double>(echoRounds.lane(lane));
+
+                MatchReport& report = reports[lane];
+                report = MatchReport{};
+                report.scoreFirst = payoff.R * static_cast<double>(cc) + payoff.S * static_cast<double>(cd)
+                    + payoff.T * static_cast<double>(dc) + payoff.P * static_cast<double>(dd);
+                report.scoreSecond = payoff.R * static_cast<double>(cc) + payoff.S * static_cast<double>(dc)
+                    + payoff.T * static_cast<double>(cd) + payoff.P * static_cast<double>(dd);
+
+                MatchMetrics& first = report.metricsFirst;
+                first.cooperations = static_cast<double>(cc + cd);
+                first.rounds = static_cast<double>(totalRounds);
+                if (firstDefectionFirst[lane] != 0) {
+                    first.firstDefection = firstDefectionFirst[lane];
+                }
+                first.echoLengthSum = echoLengthSum;
+                first.echoSamples = echoSamples;
+
+                MatchMetrics& second = report.metricsSecond;
+                second.cooperations = static_cast<double>(cc + dc);
+                second.rounds = static_cast<double>(totalRounds);
+                if (firstDefectionSecond[lane] != 0) {
+                    second.firstDefection = firstDefectionSecond[lane];
+                }
+                second.echoLengthSum = echoLengthSum;
+                second.echoSamples = echoSamples;
+            }
+        }
+    }
+
+    std::optional<LockstepKind> lockstepKindOf(Strategy& strategy) {
+        return std::visit([](auto* concrete) -> std::optional<LockstepKind> {
+            using Type = std::remove_pointer_t<decltype(concrete)>;
+            if constexpr (std::is_same_v<Type, ALLC>) {
+                return LockstepKind::ALLC;
+            }
+            else if constexpr (std::is_same_v<Type, ALLD>) {
+                return LockstepKind::ALLD;
+            }
+            else if constexpr (std::is_same_v<Type, TFT>) {
+                return LockstepKind::TFT;
+            }
+            else if constexpr (std::is_same_v<Type, GRIM>) {
+                return LockstepKind::GRIM;
+            }
+            else if constexpr (std::is_same_v<Type, PAVLOV>) {
+                return LockstepKind::PAVLOV;
+            }
+            else if constexpr (std::is_same_v<Type, CTFT>) {
+                return LockstepKind::CTFT;
+            }
+            else if constexpr (std::is_same_v<Type, Reflector>) {
+                return LockstepKind::REFLECTOR;
+            }
+            else {
+                return std::nullopt;
+            }
+            }, classifyBuiltin(strategy));
+    }
+
+    LockstepKernel::LockstepKernel(const Payoff& payoff, double epsilon)
+        : m_payoff(payoff), m_epsilon(epsilon), m_noise(epsilon) {
+    }
+
+    void LockstepKernel::play(LockstepKind first, LockstepKind second, int rounds, std::vector<Random>& rngFirst, std::vector<Random>& rngSecond, std::vector<MatchReport>& reports) {
+        const std::size_t lanes = rngFirst.size();
+        if (lanes == 0 || lanes > kLanes || rngSecond.size() != lanes) {
+            throw std::runtime_error("Lock-step kernel needs 1 to 64 lanes with one stream per player.");
+        }
+        const Probability* noise = m_epsilon > 0.0 ? &m_noise : nullptr;
+
+        withSeat(first, m_reflectorFirst, rngFirst, noise, [&](auto& seatFirst) {
+            withSeat(second, m_reflectorSecond, rngSecond, noise, [&](auto& seatSecond) {
+                playLanes(seatFirst, seatSecond, rounds, lanes, m_payoff, reports);
+                });
+            });
+    }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Match.h"
+#include "Payoff.h"
+#include "Random.h"
+#include "ReflectorBatch.h"
+#include "Strategy.h"
+
+namespace ipd {
+    // Built-ins the kernel can play. All but REFLECTOR keep at most one bit of state besides
+    // the last round and never draw from their stream; REFLECTOR runs as a ReflectorBatch.
+    enum class LockstepKind {
+        ALLC,
+        ALLD,
+        TFT,
+        GRIM,
+        PAVLOV,
+        CTFT,
+        REFLECTOR
+    };
+
+    std::optional<LockstepKind> lockstepKindOf(Strategy& strategy);
+
+    // Plays up to 64 matches of one pairing side by side, one match per bit of a 64-bit word:
+    // moves, noise flips, strategy state and outcome counters are all bit masks, so a round
+    // costs a few dozen word operations for every lane at once. Each lane takes its moves and
+    // noise from its own pair of streams exactly as Match::play does, so every lane's report
+    // equals the one Match::play would produce from the same streams.
+    class LockstepKernel {
+    public:
+        static constexpr std::size_t kLanes = 64;
+
+        LockstepKernel(const Payoff& payoff, double epsilon);
+
+        // One lane per entry of rngFirst/rngSecond (at most kLanes); reports receives one per lane.
+        void play(LockstepKind first, LockstepKind second, int rounds, std::vector<Random>& rngFirst, std::vector<Random>& rngSecond, std::vector<MatchReport>& reports);
+
+    private:
+        Payoff m_payoff;
+        double m_epsilon;
+        Probability m_noise;
+        ReflectorBatch m_reflectorFirst;
+        ReflectorBatch m_reflectorSecond;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "MEM1.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace ipd {
+    MEM1::MEM1(const std::array<double, 4>& cooperate)
+        : m_deterministic(true) {
+        std::ostringstream builder;
+        builder << "MEM1(" << std::fixed << std::setprecision(3);
+        for (std::size_t outcome = 0; outcome < 4; ++outcome) {
+            m_probabilities[outcome] = std::clamp(cooperate[outcome], 0.0, 1.0);
+            m_cooperate[outcome] = Probability(m_probabilities[outcome]);
+            m_deterministic = m_deterministic && (m_probabilities[outcome] == 0.0 || m_probabilities[outcome] == 1.0);
+            builder << (outcome > 0 ? "," : "") << m_probabilities[outcome];
+        }
+        builder << ")";
+        m_name = builder.str();
+    }
+
+    std::string MEM1::name() const {
+        return m_name;
+    }
+
+    // Outcomes are indexed 2 * own + opponent with Defect as 1, as in TransitionTable.
+    Move MEM1::nextMove(const MatchState& state, int selfIndex, Random& rng) {
+        std::size_t outcome = 0;
+        if (state.hasHistory()) {
+            const auto last = state.lastRound();
+            const Move myLast = selfIndex == 0 ? last.first : last.second;
+            const Move opponentLast = selfIndex == 0 ? last.second : last.first;
+            outcome = 2 * static_cast<std::size_t>(myLast) + static_cast<std::size_t>(opponentLast);
+        }
+        // Pure entries never touch the stream, which keeps deterministic variants cacheable.
+        if (m_probabilities[outcome] == 1.0) {
+            return Move::Cooperate;
+        }
+        if (m_probabilities[outcome] == 0.0) {
+            return Move::Defect;
+        }
+        return rng.nextBool(m_cooperate[outcome]) ? Move::Cooperate : Move::Defect;
+    }
+
+    int MEM1::complexity() const {
+        return 2;
+    }
+
+    std::size_t MEM1::historyDepth() const {
+        return 1;
+    }
+
+    bool MEM1::isDeterministic() const {
+        return m_deterministic;
+    }
+
+    std::optional<std::uint64_t> MEM1::stateSnapshot() const {
+        if (!m_deterministic) {
+            return std::nullopt;
+        }
+        return 0;
+    }
+
+    // One state per last outcome; state 0 (mutual cooperation) doubles as the opening.
+    std::optional<TransitionTable> MEM1::transitionTable() const {
+        TransitionTable table;
+        table.cooperate.assign(m_probabilities.begin(), m_probabilities.end());
+        table.next.assign(4, { 0, 1, 2, 3 });
+        return table;
+    }
+}
\ No newline at end of file
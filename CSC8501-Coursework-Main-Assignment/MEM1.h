@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+
+#include "Strategy.h"
+
+namespace ipd {
+    // Memory-one strategy MEM1(pCC,pCD,pDC,pDD): cooperates with the probability given for the
+    // last round seen from its own side (own move first). The opening move uses pCC, as if the
+    // match were preceded by mutual cooperation, so MEM1(1,0,1,0) is TFT, MEM1(1,0,0,1) PAVLOV
+    // and MEM1(0,0,0,0) ALLD.
+    class MEM1 final : public Strategy {
+    public:
+        explicit MEM1(const std::array<double, 4>& cooperate);
+        std::string name() const override;
+        Move nextMove(const MatchState& state, int selfIndex, Random& rng) override;
+        int complexity() const override;
+        std::size_t historyDepth() const override;
+        bool isDeterministic() const override;
+        std::optional<std::uint64_t> stateSnapshot() const override;
+        std::optional<TransitionTable> transitionTable() const override;
+
+    private:
+        std::array<double, 4> m_probabilities;
+        std::array<Probability, 4> m_cooperate;
+        bool m_deterministic;
+        std::string m_name;
+    };
+}
\ No newline at end of file
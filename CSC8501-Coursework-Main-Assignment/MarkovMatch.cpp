@@ -0,0 +1,244 @@
+#include "MarkovMatch.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ipd {
+    namespace {
+        // Values summed over the rounds, per starting state: each player's score, then each
+        // player's cooperations.
+        constexpr std::size_t kValues = 4;
+        constexpr int kStationaryDoublings = 52;
+
+        // Dense row-major matrix; the chains here have a few dozen states at most.
+        struct Matrix {
+            Matrix(std::size_t rowCount, std::size_t columnCount)
+                : rows(rowCount), columns(columnCount), cells(rowCount * columnCount, 0.0) {
+            }
+
+            double& at(std::size_t row, std::size_t column) { return cells[row * columns + column]; }
+            double at(std::size_t row, std::size_t column) const { return cells[row * columns + column]; }
+
+            std::size_t rows;
+            std::size_t columns;
+            std::vector<double> cells;
+        };
+
+        Matrix identity(std::size_t size) {
+            Matrix result(size, size);
+            for (std::size_t index = 0; index < size; ++index) {
+                result.at(index, index) = 1.0;
+            }
+            return result;
+        }
+
+        Matrix multiply(const Matrix& left, const Matrix& right) {
+            Matrix product(left.rows, right.columns);
+            for (std::size_t row = 0; row < left.rows; ++row) {
+                double* out = product.cells.data() + row * right.columns;
+                for (std::size_t inner = 0; inner < left.columns; ++inner) {
+                    const double weight = left.at(row, inner);
+                    if (weight == 0.0) {
+                        continue;
+                    }
+                    const double* in = right.cells.data() + inner * right.columns;
+                    for (std::size_t column = 0; column < right.columns; ++column) {
+                        out[column] += weight * in[column];
+                    }
+                }
+            }
+            return product;
+        }
+
+        // Product of two row-stochastic matrices. Rows are renormalised to sum to one: repeated
+        // squaring would otherwise raise each row's rounding error to the power 2^k.
+        Matrix multiplyStochastic(const Matrix& left, const Matrix& right) {
+            Matrix product = multiply(left, right);
+            for (std::size_t row = 0; row < product.rows; ++row) {
+                double* cells = product.cells.data() + row * product.columns;
+                double total = 0.0;
+                for (std::size_t column = 0; column < product.columns; ++column) {
+                    total += cells[column];
+                }
+                if (total > 0.0) {
+                    for (std::size_t column = 0; column < product.columns; ++column) {
+                        cells[column] /= total;
+                    }
+                }
+            }
+            return product;
+        }
+
+        void addInto(Matrix& into, const Matrix& from) {
+            for (std::size_t cell = 0; cell < into.cells.size(); ++cell) {
+                into.cells[cell] += from.cells[cell];
+            }
+        }
+
+        void validate(const TransitionTable& table) {
+            if (table.cooperate.empty() || table.cooperate.size() != table.next.size()) {
+                throw std::runtime_error("Transition table needs one successor row per state.");
+            }
+            for (const auto& successors : table.next) {
+                for (const std::size_t target : successors) {
+                    if (target >= table.cooperate.size()) {
+                        throw std::runtime_error("Transition table successor out of range.");
+                    }
+                }
+            }
+        }
+
+        double roundPayoff(bool selfDefects, bool opponentDefects, const Payoff& payoff) {
+            if (selfDefects) {
+                return opponentDefects ? payoff.P : payoff.T;
+            }
+            return opponentDefects ? payoff.S : payoff.R;
+        }
+
+        // Probability that the recorded move, after noise, is Cooperate.
+        double recordedCooperation(double intended, double noise) {
+            const double cooperate = std::clamp(intended, 0.0, 1.0);
+            return cooperate * (1.0 - noise) + (1.0 - cooperate) * noise;
+        }
+
+        // The chain over the joint states reachable from the opening (0, 0), which is state 0.
+        // Pruning matters for memory-one pairs: both players track the same last round, so
+        // only 4 of the 16 joint states occur.
+        struct JointChain {
+            Matrix step;   // one round: row = state before, column = state after
+            Matrix values; // expected values of the round played from each state
+        };
+
+        JointChain buildChain(const TransitionTable& first, const TransitionTable& second, const Payoff& payoff, double epsilon) {
+            struct Edge {
+                std::size_t from;
+                std::size_t to;
+                double probability;
+            };
+
+            const std::size_t secondStates = second.cooperate.size();
+            const double noise = std::clamp(epsilon, 0.0, 1.0);
+            constexpr std::size_t kUnseen = static_cast<std::size_t>(-1);
+            std::vector<std::size_t> compact(first.cooperate.size() * secondStates, kUnseen);
+            std::vector<std::size_t> joint{ 0 }; // joint index firstState * secondStates + secondState
+            compact[0] = 0;
+            std::vector<Edge> edges;
+            std::vector<std::array<double, kValues>> rows;
+
+            for (std::size_t state = 0; state < joint.size(); ++state) {
+                const std::size_t firstState = joint[state] / secondStates;
+                const std::size_t secondState = joint[state] % secondStates;
+                const double cooperateFirst = recordedCooperation(first.cooperate[firstState], noise);
+                const double cooperateSecond = recordedCooperation(second.cooperate[secondState], noise);
+                std::array<double, kValues> row{ 0.0, 0.0, cooperateFirst, cooperateSecond };
+                for (std::size_t outcome = 0; outcome < 4; ++outcome) {
+                    const bool firstDefects = outcome >= 2;
+                    const bool secondDefects = (outcome & 1u) != 0;
+                    const double probability = (firstDefects ? 1.0 - cooperateFirst : cooperateFirst)
+                        * (secondDefects ? 1.0 - cooperateSecond : cooperateSecond);
+                    if (probability == 0.0) {
+                        continue;
+                    }
+                    const std::size_t mirrored = 2 * (outcome & 1u) + outcome / 2; // the second player's own move first
+                    const std::size_t target = first.next[firstState][outcome] * secondStates + second.next[secondState][mirrored];
+                    if (compact[target] == kUnseen) {
+                        compact[target] = joint.size();
+                        joint.push_back(target);
+                    }
+                    edges.push_back(Edge{ state, compact[target], probability });
+                    row[0] += probability * roundPayoff(firstDefects, secondDefects, payoff);
+                    row[1] += probability * roundPayoff(secondDefects, firstDefects, payoff);
+                }
+                rows.push_back(row);
+            }
+
+            JointChain chain{ Matrix(joint.size(), joint.size()), Matrix(joint.size(), kValues) };
+            for (const Edge& edge : edges) {
+                chain.step.at(edge.from, edge.to) += edge.probability;
+            }
+            for (std::size_t state = 0; state < rows.size(); ++state) {
+                for (std::size_t value = 0; value < kValues; ++value) {
+                    chain.values.at(state, value) = rows[state][value];
+                }
+            }
+            return chain;
+        }
+    }
+
+    ExactHorizon exactHorizonFromName(const std::string& name) {
+        if (name == "finite") {
+            return ExactHorizon::Finite;
+        }
+        if (name == "stationary") {
+            return ExactHorizon::Stationary;
+        }
+        throw std::runtime_error("Unknown exact horizon: " + name);
+    }
+
+    MatchReport expectedMatch(const TransitionTable& first, const TransitionTable& second, const Payoff& payoff, double epsilon, int rounds, ExactHorizon horizon) {
+        validate(first);
+        validate(second);
+        MatchReport report;
+        if (rounds <= 0) {
+            return report;
+        }
+
+        const JointChain chain = buildChain(first, second, payoff, epsilon);
+        const std::size_t states = chain.step.rows;
+        std::array<double, kValues> totals{};
+        if (horizon == ExactHorizon::Finite) {
+            // Binary powering over the round count, most significant bit first. With
+            // power = step^k and sum = (I + step + ... + step^(k-1)) * values, doubling k is
+            // sum += power * sum, power *= power, and one more round is sum = values + step * sum,
+            // power = step * power.
+            int bit = 0;
+            while ((rounds >> (bit + 1)) != 0) {
+                ++bit;
+            }
+            Matrix power = identity(states);
+            Matrix sum(states, kValues);
+            for (; bit >= 0; --bit) {
+                addInto(sum, multiply(power, sum));
+                power = multiplyStochastic(power, power);
+                if (((rounds >> bit) & 1) != 0) {
+                    Matrix next = multiply(chain.step, sum);
+                    addInto(next, chain.values);
+                    sum = std::move(next);
+                    power = multiplyStochastic(chain.step, power);
+                }
+            }
+            for (std::size_t value = 0; value < kValues; ++value) {
+                totals[value] = sum.at(0, value);
+            }
+        }
+        else {
+            // Long-run mean per round from the opening state, taken as the average over
+            // 2^kStationaryDoublings rounds. Unlike solving for a stationary vector this also
+            // covers periodic and reducible chains (noise-free play), and the remaining
+            // transient bias is negligible unless the chain takes ~10^13 rounds to mix.
+            Matrix power = chain.step;
+            Matrix sum = chain.values;
+            double horizonRounds = 1.0;
+            for (int doubling = 0; doubling < kStationaryDoublings; ++doubling) {
+                addInto(sum, multiply(power, sum));
+                power = multiplyStochastic(power, power);
+                horizonRounds *= 2.0;
+            }
+            for (std::size_t value = 0; value < kValues; ++value) {
+                totals[value] = sum.at(0, value) / horizonRounds * static_cast<double>(rounds);
+            }
+        }
+
+        report.scoreFirst = totals[0];
+        report.scoreSecond = totals[1];
+        report.metricsFirst.cooperations = totals[2];
+        report.metricsFirst.rounds = static_cast<double>(rounds);
+        report.metricsSecond.cooperations = totals[3];
+        report.metricsSecond.rounds = static_cast<double>(rounds);
+        return report;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+
+#include "Match.h"
+#include "Payoff.h"
+#include "Strategy.h"
+
+namespace ipd {
+    ExactHorizon exactHorizonFromName(const std::string& name);
+
+    // Expected report of a match between two exported automata with per-move noise `epsilon`.
+    // The joint automaton state is a Markov chain; the sum over `rounds` rounds of its expected
+    // per-round payoffs and cooperations is taken with O(log rounds) products of S x S matrices,
+    // S being the number of reachable joint states. With ExactHorizon::Stationary the totals are
+    // instead `rounds` times the long-run mean per round. Scores and cooperations are
+    // expectations, so the report carries no first-defection or echo metrics.
+    MatchReport expectedMatch(const TransitionTable& first, const TransitionTable& second, const Payoff& payoff, double epsilon, int rounds,
+        ExactHorizon horizon = ExactHorizon::Finite);
+}
\ No newline at end of file
@@ -1,36 +1,293 @@
 #include "Match.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <variant>
+
+#include "BuiltinStrategies.h"
+#include "MarkovMatch.h"
+
 namespace ipd {
+    namespace {
+        // Give up looking for a cycle after this many rounds; finite-state strategies repeat long before.
+        constexpr int kCycleSearchLimit = 4096;
+
+        // Running per-player metrics, fed one round at a time so the match never has to
+        // walk its history afterwards. An echo starts when mutual cooperation breaks and
+        // its length counts every round up to and including the next mutual cooperation.
+        class MetricsTracker {
+        public:
+            void observe(Move self, Move opponent) {
+                ++m_rounds;
+                if (self == Move::Cooperate) {
+                    ++m_cooperations;
+                }
+                else if (m_firstDefection == 0) {
+                    m_firstDefection = m_rounds;
+                }
+
+                const bool mutualCooperate = self == Move::Cooperate && opponent == Move::Cooperate;
+                if (m_inEcho) {
+                    ++m_currentEcho;
+                }
+                else if (m_lastMutualCoop && !mutualCooperate) {
+                    m_inEcho = true;
+                    m_currentEcho = 1;
+                }
+
+                if (mutualCooperate && m_inEcho) {
+                    m_echoLengthSum += m_currentEcho;
+                    ++m_echoSamples;
+                    m_inEcho = false;
+                    m_currentEcho = 0;
+                }
+                m_lastMutualCoop = mutualCooperate;
+            }
+
+            // Replays the change accumulated since `cycleStart` another `cycles` times.
+            void repeatSince(const MetricsTracker& cycleStart, std::size_t cycles) {
+                m_rounds += cycles * (m_rounds - cycleStart.m_rounds);
+                m_cooperations += cycles * (m_cooperations - cycleStart.m_cooperations);
+                m_echoLengthSum += cycles * (m_echoLengthSum - cycleStart.m_echoLengthSum);
+                m_echoSamples += cycles * (m_echoSamples - cycleStart.m_echoSamples);
+                m_currentEcho += cycles * (m_currentEcho - cycleStart.m_currentEcho);
+            }
+
+            MatchMetrics finish() const {
+                MatchMetrics metrics;
+                metrics.cooperations = static_cast<double>(m_cooperations);
+                metrics.rounds = static_cast<double>(m_rounds);
+                if (m_firstDefection != 0) {
+                    metrics.firstDefection = static_cast<int>(m_firstDefection);
+                }
+                metrics.echoLengthSum = static_cast<double>(m_echoLengthSum);
+                metrics.echoSamples = m_echoSamples;
+                if (m_inEcho && m_currentEcho > 0) {
+                    metrics.echoLengthSum += static_cast<double>(m_currentEcho);
+                    metrics.echoSamples += 1;
+                }
+                return metrics;
+            }
+
+        private:
+            std::size_t m_rounds = 0;
+            std::size_t m_cooperations = 0;
+            std::size_t m_firstDefection = 0;
+            std::size_t m_echoLengthSum = 0;
+            std::size_t m_echoSamples = 0;
+            std::size_t m_currentEcho = 0;
+            bool m_inEcho = false;
+            bool m_lastMutualCoop = true;
+        };
+
+        // Twice the most keys one search can record, so probe chains stay short.
+        constexpr std::size_t kSeenSlots = 2 * static_cast<std::size_t>(kCycleSearchLimit);
+
+        struct CycleCheckpoint {
+            int round = 0;
+            double scoreFirst = 0.0;
+            double scoreSecond = 0.0;
+            std::size_t defectionsFirst = 0;
+            std::size_t defectionsSecond = 0;
+            MetricsTracker trackerFirst;
+            MetricsTracker trackerSecond;
+        };
+
+        unsigned int lastRoundKey(const MatchState& state) {
+            if (!state.hasHistory()) {
+                return 4;
+            }
+            const auto last = state.lastRound();
+            return static_cast<unsigned int>(last.first) | (static_cast<unsigned int>(last.second) << 1);
+        }
+    }
+
+    void Match::SeenStates::clear() {
+        for (const std::size_t slot : m_used) {
+            m_slots[slot].round = -1;
+        }
+        m_used.clear();
+    }
+
+    std::optional<int> Match::SeenStates::recall(const Key& key, int round) {
+        if (m_slots.empty()) {
+            m_slots.resize(kSeenSlots);
+            m_used.reserve(kSeenSlots);
+        }
+        std::uint64_t hash = key.first * 0x9E3779B97F4A7C15ull;
+        hash ^= (key.second + 0x632BE59BD9B4E019ull) * 0xBF58476D1CE4E5B9ull;
+        hash ^= key.lastRound;
+        hash ^= hash >> 29;
+        for (std::size_t slot = static_cast<std::size_t>(hash) & (kSeenSlots - 1);; slot = (slot + 1) & (kSeenSlots - 1)) {
+            Slot& entry = m_slots[slot];
+            if (entry.round < 0) {
+                entry.key = key;
+                entry.round = round;
+                m_used.push_back(slot);
+                return std::nullopt;
+            }
+            if (entry.key.first == key.first && entry.key.second == key.second && entry.key.lastRound == key.lastRound) {
+                return entry.round;
+            }
+        }
+    }
+
     Match::Match(const Payoff& payoff, double epsilon)
-        : m_payoff(payoff), m_epsilon(epsilon) {
+        : m_payoff(payoff), m_epsilon(epsilon), m_noise(epsilon) {
+    }
+
+    void Match::setRecordTrace(bool recordTrace) {
+        m_recordTrace = recordTrace;
+    }
+
+    void Match::setCycleSkip(bool cycleSkip) {
+        m_cycleSkip = cycleSkip;
+    }
+
+    void Match::setExactHorizon(ExactHorizon horizon) {
+        m_exactHorizon = horizon;
+    }
+
+    const Payoff& Match::payoff() const {
+        return m_payoff;
     }
 
     MatchReport Match::play(Strategy& first, Strategy& second, int rounds, Random& rng) {
+        return play(first, second, rounds, rng, rng);
+    }
+
+    MatchReport Match::play(Strategy& first, Strategy& second, int rounds, Random& rngFirst, Random& rngSecond) {
+        return std::visit([&](auto* concreteFirst, auto* concreteSecond) {
+            return playRounds(*concreteFirst, *concreteSecond, rounds, rngFirst, rngSecond);
+            }, classifyBuiltin(first), classifyBuiltin(second));
+    }
+
+    std::optional<MatchReport> Match::expected(const Strategy& first, const Strategy& second, int rounds) const {
+        const auto tableFirst = first.transitionTable();
+        const auto tableSecond = second.transitionTable();
+        if (!tableFirst || !tableSecond) {
+            return std::nullopt;
+        }
+        return expectedMatch(*tableFirst, *tableSecond, m_payoff, m_epsilon, rounds, m_exactHorizon);
+    }
+
+    // Instantiated once per pair of concrete types, so each pairing of built-ins gets its
+    // own round loop with nextMove called directly rather than through the vtable.
+    template <typename First, typename Second>
+    MatchReport Match::playRounds(First& first, Second& second, int rounds, Random& rngFirst, Random& rngSecond) {
         MatchReport report;
-        report.state.reset();
+        const std::size_t historyDepth = m_recordTrace
+            ? MatchState::kUnboundedHistory
+            : std::max(first.historyDepth(), second.historyDepth());
+        MatchState& state = m_state;
+        state.reset(historyDepth);
+        MetricsTracker trackerFirst;
+        MetricsTracker trackerSecond;
         first.reset();
         second.reset();
 
+        // The joint state is (both snapshots, last round). When it repeats after L rounds, one
+        // more period is simulated from the repeat point so the echo tracker is aligned, and
+        // its deltas are then applied for every remaining whole period.
+        bool searchingCycle = m_cycleSkip && m_epsilon <= 0.0 && !m_recordTrace;
+        SeenStates& seenStates = m_seenStates;
+        seenStates.clear();
+        std::optional<CycleCheckpoint> cycleStart;
+        int cycleLength = 0;
+
+        // Each player's stream yields the gap to its next noise event, so quiet rounds cost no
+        // draws. The legacy engine keeps one Bernoulli draw per move to reproduce old runs.
+        const bool noisy = m_epsilon > 0.0;
+        const bool perMoveNoise = rngFirst.engineKind() == RandomEngine::Mt19937;
+        std::uint64_t quietFirst = noisy && !perMoveNoise ? rngFirst.nextGap(m_noise) : 0;
+        std::uint64_t quietSecond = noisy && !perMoveNoise ? rngSecond.nextGap(m_noise) : 0;
+
         for (int round = 0; round < rounds; ++round) {
-            Move moveFirst = first.nextMove(report.state, 0, rng);
-            Move moveSecond = second.nextMove(report.state, 1, rng);
+            if (searchingCycle) {
+                if (cycleStart) {
+                    if (round == cycleStart->round + cycleLength) {
+                        searchingCycle = false;
+                        const int cycles = (rounds - round) / cycleLength;
+                        const auto repeats = static_cast<std::size_t>(cycles);
+                        report.scoreFirst += cycles * (report.scoreFirst - cycleStart->scoreFirst);
+                        report.scoreSecond += cycles * (report.scoreSecond - cycleStart->scoreSecond);
+                        trackerFirst.repeatSince(cycleStart->trackerFirst, repeats);
+                        trackerSecond.repeatSince(cycleStart->trackerSecond, repeats);
+                        state.fastForward(repeats * static_cast<std::size_t>(cycleLength),
+                            repeats * (state.defections(0) - cycleStart->defectionsFirst),
+                            repeats * (state.defections(1) - cycleStart->defectionsSecond));
+                        round += cycles * cycleLength;
+                        if (round >= rounds) {
+                            break;
+                        }
+                    }
+                }
+                else if (round >= kCycleSearchLimit) {
+                    searchingCycle = false;
+                }
+                else {
+                    const auto snapshotFirst = first.stateSnapshot();
+                    const auto snapshotSecond = second.stateSnapshot();
+                    if (!snapshotFirst || !snapshotSecond) {
+                        searchingCycle = false;
+                    }
+                    else {
+                        const SeenStates::Key key{ *snapshotFirst, *snapshotSecond, lastRoundKey(state) };
+                        if (const auto seenAt = seenStates.recall(key, round)) {
+                            cycleLength = round - *seenAt;
+                            cycleStart = CycleCheckpoint{ round, report.scoreFirst, report.scoreSecond,
+                                state.defections(0), state.defections(1), trackerFirst, trackerSecond };
+                        }
+                    }
+                }
+            }
 
-            if (m_epsilon > 0.0) {
-                if (rng.nextBool(m_epsilon)) {
+            Move moveFirst = first.nextMove(state, 0, rngFirst);
+            Move moveSecond = second.nextMove(state, 1, rngSecond);
+
+            if (noisy && perMoveNoise) {
+                if (rngFirst.nextBool(m_noise)) {
+                    moveFirst = flip(moveFirst);
+                }
+                if (rngSecond.nextBool(m_noise)) {
+                    moveSecond = flip(moveSecond);
+                }
+            }
+            else if (noisy) {
+                if (quietFirst == 0) {
                     moveFirst = flip(moveFirst);
+                    quietFirst = rngFirst.nextGap(m_noise);
                 }
-                if (rng.nextBool(m_epsilon)) {
+                else {
+                    --quietFirst;
+                }
+                if (quietSecond == 0) {
                     moveSecond = flip(moveSecond);
+                    quietSecond = rngSecond.nextGap(m_noise);
+                }
+                else {
+                    --quietSecond;
                 }
             }
 
-            report.state.recordRound(moveFirst, moveSecond);
+            state.recordRound(moveFirst, moveSecond);
+            trackerFirst.observe(moveFirst, moveSecond);
+            trackerSecond.observe(moveSecond, moveFirst);
 
             report.scoreFirst += evaluateRound(moveFirst, moveSecond);
             report.scoreSecond += evaluateRound(moveSecond, moveFirst);
         }
 
-        first.onMatchEnd(report.state, 0);
-        second.onMatchEnd(report.state, 1);
+        first.onMatchEnd(state, 0);
+        second.onMatchEnd(state, 1);
+
+        report.metricsFirst = trackerFirst.finish();
+        report.metricsSecond = trackerSecond.finish();
+        if (m_recordTrace) {
+            report.trace = state;
+        }
 
         return report;
     }
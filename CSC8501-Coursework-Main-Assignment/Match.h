@@ -1,27 +1,97 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
 #include "MatchState.h"
 #include "Payoff.h"
 #include "Strategy.h"
 #include "Random.h"
 
 namespace ipd {
+    struct MatchMetrics {
+        double cooperations = 0.0;
+        double rounds = 0.0;
+        std::optional<int> firstDefection;
+        double echoLengthSum = 0.0;
+        std::size_t echoSamples = 0;
+    };
+
     struct MatchReport {
         double scoreFirst = 0.0;
         double scoreSecond = 0.0;
-        MatchState state;
+        MatchMetrics metricsFirst;
+        MatchMetrics metricsSecond;
+        std::optional<MatchState> trace; // only kept when trace recording is enabled
+    };
+
+    // How Match::expected totals a match: over its actual rounds, or as `rounds` times the
+    // long-run mean per round of the two automata.
+    enum class ExactHorizon {
+        Finite,
+        Stationary
     };
 
     class Match {
     public:
         Match(const Payoff& payoff, double epsilon);
 
+        void setRecordTrace(bool recordTrace);
+        // Noise-free matches between snapshot-capable strategies stop simulating once the
+        // joint state repeats and account for the remaining whole cycles in closed form.
+        void setCycleSkip(bool cycleSkip);
+        void setExactHorizon(ExactHorizon horizon);
+        const Payoff& payoff() const;
+
+        // play() reuses one MatchState across calls, so give each thread its own Match.
         MatchReport play(Strategy& first, Strategy& second, int rounds, Random& rng);
+        // Each player draws its own decisions and its own noise from a dedicated stream.
+        // Built-in strategies are dispatched statically; others go through Strategy's vtable.
+        MatchReport play(Strategy& first, Strategy& second, int rounds, Random& rngFirst, Random& rngSecond);
+        // Expected report from the two strategies' transition tables (see MarkovMatch.h), or
+        // nullopt when either has none.
+        std::optional<MatchReport> expected(const Strategy& first, const Strategy& second, int rounds) const;
 
     private:
+        // Joint states seen by the cycle search, keyed by both strategy snapshots and the last
+        // round, with the round each first appeared. Open addressing over slots kept across
+        // matches, so a steady stream of matches does not allocate; clear() resets only the
+        // slots the previous match used.
+        class SeenStates {
+        public:
+            struct Key {
+                std::uint64_t first;
+                std::uint64_t second;
+                unsigned int lastRound;
+            };
+
+            void clear();
+            // The round `key` was first recorded at, or nullopt after recording it at `round`.
+            std::optional<int> recall(const Key& key, int round);
+
+        private:
+            struct Slot {
+                Key key;
+                int round = -1; // -1 marks an empty slot
+            };
+
+            std::vector<Slot> m_slots;
+            std::vector<std::size_t> m_used;
+        };
+
+        template <typename First, typename Second>
+        MatchReport playRounds(First& first, Second& second, int rounds, Random& rngFirst, Random& rngSecond);
         double evaluateRound(Move first, Move second) const;
 
         Payoff m_payoff;
         double m_epsilon;
+        Probability m_noise;
+        bool m_recordTrace = false;
+        bool m_cycleSkip = true;
+        ExactHorizon m_exactHorizon = ExactHorizon::Finite;
+        MatchState m_state;
+        SeenStates m_seenStates;
     };
 }
\ No newline at end of file
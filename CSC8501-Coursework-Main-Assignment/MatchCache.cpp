@@ -0,0 +1,45 @@
+#include "MatchCache.h"
+
+namespace ipd {
+    MatchCache& MatchCache::instance() {
+        static MatchCache instance;
+        return instance;
+    }
+
+    MatchCache::KeyView MatchCache::makeKey(const std::string& first, const std::string& second, int rounds, const Payoff& payoff) {
+        return KeyView{ first, second, rounds, payoff.T, payoff.R, payoff.P, payoff.S };
+    }
+
+    std::optional<MatchReport> MatchCache::find(const std::string& first, const std::string& second, int rounds, const Payoff& payoff) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_reports.find(makeKey(first, second, rounds, payoff));
+        if (it == m_reports.end()) {
+            ++m_misses;
+            return std::nullopt;
+        }
+        ++m_hits;
+        return it->second;
+    }
+
+    void MatchCache::store(const std::string& first, const std::string& second, int rounds, const Payoff& payoff, const MatchReport& report) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_reports.emplace(Key{ first, second, rounds, payoff.T, payoff.R, payoff.P, payoff.S }, report);
+    }
+
+    void MatchCache::clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_reports.clear();
+        m_hits = 0;
+        m_misses = 0;
+    }
+
+    std::size_t MatchCache::hits() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_hits;
+    }
+
+    std::size_t MatchCache::misses() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_misses;
+    }
+}
\ No newline at end of file
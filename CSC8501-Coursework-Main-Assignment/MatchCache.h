@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include "Match.h"
+#include "Payoff.h"
+
+namespace ipd {
+    // Process-wide memo of noise-free matches between deterministic strategies. Such a
+    // match always yields the same report, so repeats, generations and mirrored schedules
+    // can share one simulation. Safe to use from tournament worker threads.
+    class MatchCache {
+    public:
+        static MatchCache& instance();
+
+        std::optional<MatchReport> find(const std::string& first, const std::string& second, int rounds, const Payoff& payoff);
+        void store(const std::string& first, const std::string& second, int rounds, const Payoff& payoff, const MatchReport& report);
+        void clear();
+
+        std::size_t hits() const;
+        std::size_t misses() const;
+
+    private:
+        using Key = std::tuple<std::string, std::string, int, double, double, double, double>;
+        // Borrowed form of Key, so lookups compare in place without copying the names.
+        using KeyView = std::tuple<std::string_view, std::string_view, int, double, double, double, double>;
+
+        MatchCache() = default;
+        static KeyView makeKey(const std::string& first, const std::string& second, int rounds, const Payoff& payoff);
+
+        mutable std::mutex m_mutex;
+        std::map<Key, MatchReport, std::less<>> m_reports;
+        std::size_t m_hits = 0;
+        std::size_t m_misses = 0;
+    };
+}
\ No newline at end of file
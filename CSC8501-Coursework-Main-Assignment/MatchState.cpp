@@ -1,61 +1,164 @@
 #include "MatchState.h"
 
 #include <stdexcept>
+#include <string>
 
 namespace ipd {
-    MatchState::MatchState() = default;
+    static_assert(static_cast<int>(Move::Cooperate) == 0 && static_cast<int>(Move::Defect) == 1,
+        "MatchState packs Move values directly into bits");
+
+    namespace {
+        constexpr std::size_t kWordBits = 64;
+
+        inline unsigned int bitOf(Move move) {
+            return static_cast<unsigned int>(move);
+        }
+
+        inline Move moveOf(std::uint64_t bit) {
+            return static_cast<Move>(bit & 1u);
+        }
+
+        // One spare word so the previous `historyDepth` rounds survive a word rollover.
+        std::size_t windowWordsFor(std::size_t historyDepth) {
+            return historyDepth == MatchState::kUnboundedHistory ? 0 : historyDepth / kWordBits + 2;
+        }
+    }
+
+    MatchState::MatchState(std::size_t historyDepth)
+        : m_windowWords(windowWordsFor(historyDepth)) {
+        if (m_windowWords != 0) {
+            m_bits[0].assign(m_windowWords, 0);
+            m_bits[1].assign(m_windowWords, 0);
+        }
+    }
+
+    void MatchState::reset(std::size_t historyDepth) {
+        m_windowWords = windowWordsFor(historyDepth);
+        if (m_windowWords != 0) {
+            m_bits[0].assign(m_windowWords, 0);
+            m_bits[1].assign(m_windowWords, 0);
+        }
+        reset();
+    }
 
     void MatchState::reset() {
-        m_history.clear();
+        if (m_windowWords == 0) {
+            m_bits[0].clear();
+            m_bits[1].clear();
+        }
+        m_currentSlot = 0;
+        m_firstRetained = 0;
+        m_defections = {};
+        m_rounds = 0;
+        m_last = 0;
     }
 
     void MatchState::recordRound(Move first, Move second) {
-        m_history.push_back({ first, second });
+        const std::size_t offset = m_rounds % kWordBits;
+        if (offset == 0) {
+            if (m_windowWords == 0) {
+                m_currentSlot = m_bits[0].size();
+                m_bits[0].push_back(0);
+                m_bits[1].push_back(0);
+            }
+            else {
+                m_currentSlot = slotOf(m_rounds / kWordBits);
+                m_bits[0][m_currentSlot] = 0;
+                m_bits[1][m_currentSlot] = 0;
+            }
+        }
+        const unsigned int firstBit = bitOf(first);
+        const unsigned int secondBit = bitOf(second);
+        m_bits[0][m_currentSlot] |= static_cast<std::uint64_t>(firstBit) << offset;
+        m_bits[1][m_currentSlot] |= static_cast<std::uint64_t>(secondBit) << offset;
+        m_defections[0] += firstBit;
+        m_defections[1] += secondBit;
+        m_last = firstBit | (secondBit << 1);
+        ++m_rounds;
     }
 
     std::size_t MatchState::roundsPlayed() const {
-        return m_history.size();
+        return m_rounds;
     }
 
     bool MatchState::hasHistory() const {
-        return !m_history.empty();
+        return m_rounds != 0;
     }
 
     MatchState::Round MatchState::lastRound() const {
-        if (m_history.empty()) {
-            throw std::runtime_error("No rounds have been played yet");
-        }
-        return m_history.back();
+        return { moveOf(m_last), moveOf(m_last >> 1) };
     }
 
     Move MatchState::lastMove(int playerIndex) const {
-        if (m_history.empty()) {
-            throw std::runtime_error("No rounds have been played yet");
+        return moveOf(m_last >> (playerIndex & 1));
+    }
+
+    Move MatchState::lastOpponentMove(int playerIndex) const {
+        return moveOf(m_last >> ((playerIndex & 1) ^ 1));
+    }
+
+    std::size_t MatchState::defections(int playerIndex) const {
+        return m_defections[playerIndex & 1];
+    }
+
+    void MatchState::fastForward(std::size_t rounds, std::size_t defectionsFirst, std::size_t defectionsSecond) {
+        if (rounds == 0) {
+            return;
         }
+        m_rounds += rounds;
+        m_defections[0] += defectionsFirst;
+        m_defections[1] += defectionsSecond;
+        m_firstRetained = m_rounds;
 
-        return playerIndex == 0 ? m_history.back().first : m_history.back().second;
+        const std::size_t word = m_rounds / kWordBits;
+        const bool partialWord = m_rounds % kWordBits != 0;
+        if (m_windowWords == 0) {
+            m_bits[0].resize(word + (partialWord ? 1 : 0), 0);
+            m_bits[1].resize(word + (partialWord ? 1 : 0), 0);
+        }
+        if (partialWord) {
+            m_currentSlot = slotOf(word);
+            m_bits[0][m_currentSlot] = 0;
+            m_bits[1][m_currentSlot] = 0;
+        }
     }
 
-    Move MatchState::lastOpponentMove(int playerIndex) const {
-        if (m_history.empty()) {
-            throw std::runtime_error("No rounds have been played yet");
+    bool MatchState::isRetained(std::size_t index) const {
+        if (index >= m_rounds || index < m_firstRetained) {
+            return false;
         }
+        if (m_windowWords == 0) {
+            return true;
+        }
+        const std::size_t newestWord = (m_rounds - 1) / kWordBits;
+        return index / kWordBits + m_windowWords > newestWord;
+    }
 
-        return playerIndex == 0 ? m_history.back().second : m_history.back().first;
+    MatchState::Round MatchState::round(std::size_t index) const {
+        return { move(0, index), move(1, index) };
     }
 
-    std::size_t MatchState::defections(int playerIndex) const {
-        std::size_t count = 0;
-        for (const auto& round : m_history) {
-            const auto move = playerIndex == 0 ? round.first : round.second;
-            if (move == Move::Defect) {
-                ++count;
-            }
+    Move MatchState::move(int playerIndex, std::size_t index) const {
+        if (!isRetained(index)) {
+            throw std::out_of_range("Round " + std::to_string(index) + " is not retained in the match history");
         }
-        return count;
+        return moveOf(defectionWord(playerIndex, index / kWordBits) >> (index % kWordBits));
     }
 
-    const std::vector<MatchState::Round>& MatchState::history() const {
-        return m_history;
+    std::uint64_t MatchState::defectionWord(int playerIndex, std::size_t wordIndex) const {
+        return m_bits[playerIndex & 1][slotOf(wordIndex)];
+    }
+
+    std::size_t MatchState::slotOf(std::size_t wordIndex) const {
+        return m_windowWords == 0 ? wordIndex : wordIndex % m_windowWords;
+    }
+
+    std::vector<MatchState::Round> MatchState::history() const {
+        std::vector<Round> rounds;
+        rounds.reserve(m_rounds);
+        for (std::size_t index = 0; index < m_rounds; ++index) {
+            rounds.push_back(round(index));
+        }
+        return rounds;
     }
-}
\ No newline at end of file
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -8,6 +10,9 @@
 #include "Move.h"
 
 namespace ipd {
+    // Round history packed as one bitset per player (bit set = defected), 64 rounds per
+    // word, with running defection counters so every query is O(1). With a finite history
+    // depth the words live in a fixed ring, so memory stays constant however long the match.
     class MatchState {
     public:
         struct Round {
@@ -15,21 +20,44 @@ namespace ipd {
             Move second;
         };
 
-        MatchState();
+        static constexpr std::size_t kUnboundedHistory = static_cast<std::size_t>(-1);
+
+        explicit MatchState(std::size_t historyDepth = kUnboundedHistory);
 
         void reset();
+        // Starts a new match with a different history depth, reusing the storage already held.
+        void reset(std::size_t historyDepth);
         void recordRound(Move first, Move second);
 
         std::size_t roundsPlayed() const;
         bool hasHistory() const;
+        // Before the first round these report mutual cooperation instead of throwing.
         Round lastRound() const;
         Move lastMove(int playerIndex) const;
         Move lastOpponentMove(int playerIndex) const;
         std::size_t defections(int playerIndex) const;
+        // Advances the counters over rounds the caller accounted for without simulating them.
+        // Only the last round stays queryable; earlier rounds stop being retained.
+        void fastForward(std::size_t rounds, std::size_t defectionsFirst, std::size_t defectionsSecond);
+
+        // Indexed access is limited to retained rounds; older ones throw std::out_of_range.
+        bool isRetained(std::size_t index) const;
+        Round round(std::size_t index) const;
+        Move move(int playerIndex, std::size_t index) const;
+        // Word w holds rounds [64w, 64w + 63]; bit (r % 64) is set if the player defected in round r.
+        std::uint64_t defectionWord(int playerIndex, std::size_t wordIndex) const;
 
-        const std::vector<Round>& history() const;
+        std::vector<Round> history() const;
 
     private:
-        std::vector<Round> m_history;
+        std::size_t slotOf(std::size_t wordIndex) const;
+
+        std::size_t m_windowWords; // 0 keeps every word
+        std::size_t m_currentSlot = 0;
+        std::array<std::vector<std::uint64_t>, 2> m_bits;
+        std::array<std::size_t, 2> m_defections{};
+        std::size_t m_rounds = 0;
+        std::size_t m_firstRetained = 0;
+        unsigned int m_last = 0; // bit 0: first player defected last round, bit 1: second player
     };
-}
\ No newline at end of file
+}
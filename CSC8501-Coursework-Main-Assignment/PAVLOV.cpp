@@ -26,4 +26,21 @@ namespace ipd {
     int PAVLOV::complexity() const {
         return 2;
     }
+
+    std::size_t PAVLOV::historyDepth() const {
+        return 1;
+    }
+
+    bool PAVLOV::isDeterministic() const {
+        return true;
+    }
+
+    std::optional<std::uint64_t> PAVLOV::stateSnapshot() const {
+        return static_cast<std::uint64_t>(m_lastMove);
+    }
+
+    // The state is the intended move, which switches whenever the recorded moves differ.
+    std::optional<TransitionTable> PAVLOV::transitionTable() const {
+        return TransitionTable{ { 1.0, 0.0 }, { { 0, 1, 1, 0 }, { 1, 0, 0, 1 } } };
+    }
 }
\ No newline at end of file
@@ -3,12 +3,16 @@
 #include "Strategy.h"
 
 namespace ipd{
-    class PAVLOV : public Strategy {
+    class PAVLOV final : public Strategy {
     public:
         std::string name() const override;
         Move nextMove(const MatchState& state, int selfIndex, Random& rng) override;
         void reset() override;
         int complexity() const override;
+        std::size_t historyDepth() const override;
+        bool isDeterministic() const override;
+        std::optional<std::uint64_t> stateSnapshot() const override;
+        std::optional<TransitionTable> transitionTable() const override;
 
     private:
         Move m_lastMove = Move::Cooperate;
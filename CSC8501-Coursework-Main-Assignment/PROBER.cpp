@@ -19,13 +19,10 @@ namespace ipd {
         }
         if (m_round == 2) {
             ++m_round;
-            if (state.hasHistory()) {
-                const auto& history = state.history();
-                if (history.size() >= 2) {
-                    const Move opp0 = selfIndex == 0 ? history[0].second : history[0].first;
-                    const Move opp1 = selfIndex == 0 ? history[1].second : history[1].first;
-                    m_exploit = (opp0 == Move::Cooperate && opp1 == Move::Cooperate);
-                }
+            if (state.roundsPlayed() >= 2) {
+                // Exploit only if the opponent cooperated in both opening rounds.
+                const std::uint64_t opening = state.defectionWord(1 - selfIndex, 0) & 0b11u;
+                m_exploit = opening == 0;
             }
             return Move::Cooperate;
         }
@@ -49,4 +46,16 @@ namespace ipd {
     int PROBER::complexity() const {
         return 3;
     }
+
+    std::size_t PROBER::historyDepth() const {
+        return 2;
+    }
+
+    bool PROBER::isDeterministic() const {
+        return true;
+    }
+
+    std::optional<std::uint64_t> PROBER::stateSnapshot() const {
+        return static_cast<std::uint64_t>(m_round) * 2u + (m_exploit ? 1u : 0u);
+    }
 }
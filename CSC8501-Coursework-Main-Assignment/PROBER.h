@@ -3,7 +3,7 @@
 #include "Strategy.h"
 
 namespace ipd {
-    class PROBER : public Strategy {
+    class PROBER final : public Strategy {
     public:
         PROBER();
 
@@ -11,6 +11,9 @@ namespace ipd {
         Move nextMove(const MatchState& state, int selfIndex, Random& rng) override;
         void reset() override;
         int complexity() const override;
+        std::size_t historyDepth() const override;
+        bool isDeterministic() const override;
+        std::optional<std::uint64_t> stateSnapshot() const override;
 
     private:
         int m_round;
@@ -6,10 +6,20 @@
 #include <sstream>
 
 namespace ipd {
+    namespace {
+        // Probabilities within rounding of one half are the fair coin: named "RND" and drawn
+        // with Random::nextCoin.
+        double normalisedProbability(double probability) {
+            const double clamped = std::clamp(probability, 0.0, 1.0);
+            return std::abs(clamped - 0.5) < 1e-9 ? 0.5 : clamped;
+        }
+    }
+
     RND::RND(double probability)
-        : m_probability(probability) {
-        m_probability = std::clamp(m_probability, 0.0, 1.0);
-        if (std::abs(m_probability - 0.5) < 1e-9) {
+        : m_probability(normalisedProbability(probability))
+        , m_cooperate(m_probability)
+        , m_fair(m_probability == 0.5) {
+        if (m_fair) {
             m_name = "RND";
             return;
         }
@@ -23,10 +33,21 @@ namespace ipd {
     }
 
     Move RND::nextMove(const MatchState&, int, Random& rng) {
-        return rng.nextBool(m_probability) ? Move::Cooperate : Move::Defect;
+        if (m_fair) {
+            return rng.nextCoin() ? Move::Cooperate : Move::Defect;
+        }
+        return rng.nextBool(m_cooperate) ? Move::Cooperate : Move::Defect;
     }
 
     int RND::complexity() const {
         return 2;
     }
+
+    std::size_t RND::historyDepth() const {
+        return 0;
+    }
+
+    std::optional<TransitionTable> RND::transitionTable() const {
+        return TransitionTable{ { m_probability }, { { 0, 0, 0, 0 } } };
+    }
 }
\ No newline at end of file
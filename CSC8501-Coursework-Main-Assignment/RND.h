@@ -3,15 +3,19 @@
 #include "Strategy.h"
 
 namespace ipd {
-    class RND : public Strategy {
+    class RND final : public Strategy {
     public:
         explicit RND(double probability = 0.5);
         std::string name() const override;
         Move nextMove(const MatchState& state, int selfIndex, Random& rng) override;
         int complexity() const override;
+        std::size_t historyDepth() const override;
+        std::optional<TransitionTable> transitionTable() const override;
 
     private:
         double m_probability;
+        Probability m_cooperate;
+        bool m_fair;
         std::string m_name;
     };
 }
\ No newline at end of file
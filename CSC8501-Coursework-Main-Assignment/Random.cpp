@@ -1,41 +1,267 @@
 #include "Random.h"
 
 #include <chrono>
+#include <cmath>
+#include <stdexcept>
 
 namespace ipd {
     namespace {
+        constexpr std::uint32_t kPhiloxM0 = 0xD2511F53u;
+        constexpr std::uint32_t kPhiloxM1 = 0xCD9E8D57u;
+        constexpr std::uint32_t kPhiloxW0 = 0x9E3779B9u;
+        constexpr std::uint32_t kPhiloxW1 = 0xBB67AE85u;
+        constexpr int kPhiloxRounds = 10;
+        constexpr double kUnitScale = 1.0 / 9007199254740992.0; // 2^-53
+
         std::mt19937 makeRandomEngine() {
             const auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
             return std::mt19937(static_cast<unsigned int>(now.count()));
         }
+
+        inline void mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t& hi, std::uint32_t& lo) {
+            const std::uint64_t product = static_cast<std::uint64_t>(a) * static_cast<std::uint64_t>(b);
+            hi = static_cast<std::uint32_t>(product >> 32);
+            lo = static_cast<std::uint32_t>(product);
+        }
+
+        inline std::uint64_t rotl(std::uint64_t value, int shift) {
+            return (value << shift) | (value >> (64 - shift));
+        }
+
+        std::uint64_t splitmix64(std::uint64_t& state) {
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+    }
+
+    RandomEngine randomEngineFromName(const std::string& name) {
+        if (name == "philox") {
+            return RandomEngine::Philox;
+        }
+        if (name == "xoshiro") {
+            return RandomEngine::Xoshiro256;
+        }
+        if (name == "mt19937") {
+            return RandomEngine::Mt19937;
+        }
+        throw std::runtime_error("Unknown random engine: " + name);
+    }
+
+    std::string toString(RandomEngine engine) {
+        switch (engine) {
+        case RandomEngine::Philox:
+            return "philox";
+        case RandomEngine::Xoshiro256:
+            return "xoshiro";
+        case RandomEngine::Mt19937:
+        default:
+            return "mt19937";
+        }
+    }
+
+    Philox4x32::Philox4x32(std::uint32_t key0, std::uint32_t key1, std::uint32_t stream0, std::uint32_t stream1)
+        : m_key{ key0, key1 }
+        , m_counter{ 0u, 0u, stream0, stream1 } {
+    }
+
+    Philox4x32::result_type Philox4x32::operator()() {
+        if (m_index == m_block.size()) {
+            refill();
+        }
+        return m_block[m_index++];
+    }
+
+    std::uint64_t Philox4x32::next64() {
+        const std::uint64_t high = (*this)();
+        return (high << 32) | (*this)();
+    }
+
+    void Philox4x32::refill() {
+        std::array<std::uint32_t, 4> block = m_counter;
+        std::uint32_t key0 = m_key[0];
+        std::uint32_t key1 = m_key[1];
+        for (int round = 0; round < kPhiloxRounds; ++round) {
+            std::uint32_t hi0, lo0, hi1, lo1;
+            mulhilo(kPhiloxM0, block[0], hi0, lo0);
+            mulhilo(kPhiloxM1, block[2], hi1, lo1);
+            block = { hi1 ^ block[1] ^ key0, lo1, hi0 ^ block[3] ^ key1, lo0 };
+            key0 += kPhiloxW0;
+            key1 += kPhiloxW1;
+        }
+        m_block = block;
+        m_index = 0;
+
+        // The low two words form a 64-bit block counter; the high two identify the stream.
+        if (++m_counter[0] == 0u) {
+            ++m_counter[1];
+        }
+    }
+
+    Xoshiro256::Xoshiro256(std::uint64_t seed) {
+        for (auto& word : m_state) {
+            word = splitmix64(seed);
+        }
+    }
+
+    Xoshiro256::result_type Xoshiro256::operator()() {
+        const std::uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+        const std::uint64_t shifted = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= shifted;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
     }
 
     Random::Random()
         : m_engine(makeRandomEngine()) {}
 
     Random::Random(unsigned int seed)
-        : m_engine(seed) {}
+        : m_engine(std::mt19937(seed)) {}
+
+    Random::Random(Engine engine)
+        : m_engine(std::move(engine)) {}
+
+    Random Random::stream(unsigned int seed, std::uint32_t repeat, std::uint32_t pairIndex, std::uint32_t player, RandomEngine engine) {
+        switch (engine) {
+        case RandomEngine::Xoshiro256: {
+            std::uint64_t key = seed;
+            key = splitmix64(key) ^ repeat;
+            key = splitmix64(key) ^ pairIndex;
+            key = splitmix64(key) ^ player;
+            return Random(Engine(Xoshiro256(splitmix64(key))));
+        }
+        case RandomEngine::Mt19937: {
+            std::seed_seq sequence{ seed, repeat, pairIndex, player };
+            return Random(Engine(std::mt19937(sequence)));
+        }
+        case RandomEngine::Philox:
+        default:
+            return Random(Engine(Philox4x32(seed, pairIndex, repeat, player)));
+        }
+    }
 
     void Random::reseed(unsigned int seed) {
-        m_engine.seed(seed);
-}
+        m_engine = std::mt19937(seed);
+        m_coinsLeft = 0;
+    }
+
+    RandomEngine Random::engineKind() const {
+        if (std::holds_alternative<Philox4x32>(m_engine)) {
+            return RandomEngine::Philox;
+        }
+        if (std::holds_alternative<Xoshiro256>(m_engine)) {
+            return RandomEngine::Xoshiro256;
+        }
+        return RandomEngine::Mt19937;
+    }
+
+    bool Random::isLegacy() const {
+        return m_engine.index() == 0;
+    }
 
+    // The mt19937 path keeps the original <random> distributions so historical runs
+    // stay bit-for-bit reproducible; the other engines work on raw 64-bit words.
     double Random::nextDouble(double minInclusive, double maxExclusive) {
-        std::uniform_real_distribution<double> distribution(minInclusive, maxExclusive);
-        return distribution(m_engine);
+        if (isLegacy()) {
+            std::uniform_real_distribution<double> distribution(minInclusive, maxExclusive);
+            return distribution(*this);
+        }
+        return minInclusive + (maxExclusive - minInclusive) * nextUnit();
     }
 
     bool Random::nextBool(double probability) {
-        std::bernoulli_distribution distribution(probability);
-        return distribution(m_engine);
+        if (isLegacy()) {
+            std::bernoulli_distribution distribution(probability);
+            return distribution(*this);
+        }
+        return nextBool(Probability(probability));
+    }
+
+    bool Random::nextBool(const Probability& probability) {
+        if (isLegacy()) {
+            std::bernoulli_distribution distribution(probability.value());
+            return distribution(*this);
+        }
+        return (nextBits() >> 11) < probability.threshold();
+    }
+
+    std::uint64_t Random::nextGap(const Probability& probability) {
+        if (probability.value() >= 1.0) {
+            return 0;
+        }
+        if (probability.value() <= 0.0) {
+            return kNever;
+        }
+        const double unit = 1.0 - nextUnit(); // (0, 1], so the logarithm stays finite
+        const double gap = std::floor(std::log(unit) / std::log1p(-probability.value()));
+        return gap < 9.2e18 ? static_cast<std::uint64_t>(gap) : kNever;
     }
 
     int Random::nextInt(int minInclusive, int maxInclusive) {
-        std::uniform_int_distribution<int> distribution(minInclusive, maxInclusive);
-        return distribution(m_engine);
+        if (isLegacy()) {
+            std::uniform_int_distribution<int> distribution(minInclusive, maxInclusive);
+            return distribution(*this);
+        }
+        const std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(maxInclusive) - minInclusive) + 1;
+        const std::uint64_t rejectBelow = (0 - range) % range;
+        std::uint64_t bits = nextBits();
+        while (bits < rejectBelow) {
+            bits = nextBits();
+        }
+        return static_cast<int>(minInclusive + static_cast<std::int64_t>(bits % range));
     }
 
-    std::mt19937& Random::engine() {
-        return m_engine;
+    bool Random::nextCoin() {
+        if (isLegacy()) {
+            return nextBool(0.5);
+        }
+        if (m_coinsLeft == 0) {
+            m_coinBits = nextBits();
+            m_coinsLeft = 64;
+        }
+        const bool coin = (m_coinBits & 1u) != 0;
+        m_coinBits >>= 1;
+        --m_coinsLeft;
+        return coin;
+    }
+
+    std::uint64_t Random::nextBits() {
+        switch (m_engine.index()) {
+        case 1:
+            return std::get<Philox4x32>(m_engine).next64();
+        case 2:
+            return std::get<Xoshiro256>(m_engine)();
+        default: {
+            auto& engine = std::get<std::mt19937>(m_engine);
+            const std::uint64_t high = static_cast<std::uint32_t>(engine());
+            return (high << 32) | static_cast<std::uint32_t>(engine());
+        }
+        }
+    }
+
+    void Random::fillBits(std::uint64_t* out, std::size_t count) {
+        for (std::size_t index = 0; index < count; ++index) {
+            out[index] = nextBits();
+        }
+    }
+
+    double Random::nextUnit() {
+        return static_cast<double>(nextBits() >> 11) * kUnitScale;
+    }
+
+    Random::result_type Random::operator()() {
+        switch (m_engine.index()) {
+        case 1:
+            return std::get<Philox4x32>(m_engine)();
+        case 2:
+            return static_cast<result_type>(std::get<Xoshiro256>(m_engine)() >> 32);
+        default:
+            return static_cast<result_type>(std::get<std::mt19937>(m_engine)());
+        }
     }
 }
@@ -1,20 +1,121 @@
 #pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <random>
+#include <string>
+#include <variant>
 namespace ipd {
+    enum class RandomEngine {
+        Philox,
+        Xoshiro256,
+        Mt19937 // legacy: reproduces outputs produced before per-match streams existed
+    };
+
+    RandomEngine randomEngineFromName(const std::string& name);
+    std::string toString(RandomEngine engine);
+
+    // Bernoulli parameter with its 53-bit integer threshold computed once, so hot
+    // loops compare raw random bits instead of building a distribution per draw.
+    class Probability {
+    public:
+        constexpr Probability(double value = 0.5)
+            : m_value(value < 0.0 ? 0.0 : (value > 1.0 ? 1.0 : value))
+            , m_threshold(static_cast<std::uint64_t>(m_value * 9007199254740992.0)) {
+        }
+
+        constexpr double value() const { return m_value; }
+        constexpr std::uint64_t threshold() const { return m_threshold; }
+
+    private:
+        double m_value;
+        std::uint64_t m_threshold;
+    };
+
+    // Philox4x32-10 counter-based generator (Salmon et al., SC'11). The output is a pure
+    // function of (key, counter), so any stream can be recreated without replaying others.
+    class Philox4x32 {
+    public:
+        using result_type = std::uint32_t;
+
+        Philox4x32(std::uint32_t key0, std::uint32_t key1, std::uint32_t stream0, std::uint32_t stream1);
+
+        result_type operator()();
+        std::uint64_t next64();
+
+        static constexpr result_type min() { return 0u; }
+        static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+    private:
+        void refill();
+
+        std::array<std::uint32_t, 2> m_key;
+        std::array<std::uint32_t, 4> m_counter;
+        std::array<std::uint32_t, 4> m_block{};
+        std::size_t m_index = 4;
+    };
+
+    // xoshiro256** (Blackman & Vigna): 32 bytes of state, seeded through splitmix64.
+    class Xoshiro256 {
+    public:
+        using result_type = std::uint64_t;
+
+        explicit Xoshiro256(std::uint64_t seed);
+
+        result_type operator()();
+
+        static constexpr result_type min() { return 0u; }
+        static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+    private:
+        std::array<std::uint64_t, 4> m_state;
+    };
+
     class Random {
     public:
+        using result_type = std::uint32_t;
+
+        static constexpr std::uint64_t kNever = ~static_cast<std::uint64_t>(0);
+
         Random();
         explicit Random(unsigned int seed);
 
+        // Stream for one player of one scheduled match. The same
+        // (seed, repeat, pairIndex, player) always yields the same sequence.
+        static Random stream(unsigned int seed, std::uint32_t repeat, std::uint32_t pairIndex, std::uint32_t player,
+            RandomEngine engine = RandomEngine::Philox);
+
         void reseed(unsigned int seed);
+        RandomEngine engineKind() const;
 
         double nextDouble(double minInclusive = 0.0, double maxExclusive = 1.0);
         bool nextBool(double probability = 0.5);
+        bool nextBool(const Probability& probability);
+        // Number of failed Bernoulli(probability) trials before the next success, drawn by
+        // inversion; kNever when the probability is zero.
+        std::uint64_t nextGap(const Probability& probability);
         int nextInt(int minInclusive, int maxInclusive);
 
-        std::mt19937& engine();
+        // Fair coin served from a cached 64-bit word: one generator call per 64 flips.
+        bool nextCoin();
+        std::uint64_t nextBits();
+        void fillBits(std::uint64_t* out, std::size_t count);
+
+        result_type operator()();
+
+        static constexpr result_type min() { return 0u; }
+        static constexpr result_type max() { return 0xFFFFFFFFu; }
 
     private:
-        std::mt19937 m_engine;
+        using Engine = std::variant<std::mt19937, Philox4x32, Xoshiro256>;
+
+        explicit Random(Engine engine);
+
+        bool isLegacy() const;
+        double nextUnit();
+
+        Engine m_engine;
+        std::uint64_t m_coinBits = 0;
+        int m_coinsLeft = 0;
     };
-}
\ No newline at end of file
+}
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 
+#include "FpContract.h" // ReflectorBatch must reproduce these updates exactly
+
 namespace ipd {
     Reflector::Reflector()
         : m_trust(0.5)
@@ -3,7 +3,7 @@
 #include "Strategy.h"
 
 namespace ipd {
-    class Reflector : public Strategy {
+    class Reflector final : public Strategy {
     public:
         Reflector();
 
@@ -11,14 +11,9 @@ namespace ipd {
         Move nextMove(const MatchState& state, int selfIndex, Random& rng) override;
         void reset() override;
 		int complexity() const override { return 3; }
+        std::size_t historyDepth() const override { return 1; }
 
-    private:
-        double payoffFor(Move self, Move opponent) const;
-
-        double m_trust;
-        double m_mood;
-        double m_expectedReward;
-
+        // Learning constants, shared with ReflectorBatch.
         static constexpr double s_eta = 0.1;
         static constexpr double s_alpha = 0.2;
         static constexpr double s_beta = 0.2;
@@ -26,5 +21,12 @@ namespace ipd {
         static constexpr double s_reward = 3.0;
         static constexpr double s_punishment = 1.0;
         static constexpr double s_sucker = 0.0;
+
+    private:
+        double payoffFor(Move self, Move opponent) const;
+
+        double m_trust;
+        double m_mood;
+        double m_expectedReward;
     };
 }
\ No newline at end of file
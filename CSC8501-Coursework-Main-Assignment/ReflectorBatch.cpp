@@ -0,0 +1,125 @@
+#include "ReflectorBatch.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define IPD_REFLECTOR_SSE2 1
+#else
+#define IPD_REFLECTOR_SSE2 0
+#endif
+
+#include "FpContract.h"
+#include "Reflector.h"
+
+namespace ipd {
+    namespace {
+        constexpr double kEta = Reflector::s_eta;
+        // The payoff of (self, opponent) as a bilinear form in the two 0/1 defection flags;
+        // the payoffs are small integers, so it is exact.
+        constexpr double kSelfTerm = Reflector::s_temptation - Reflector::s_reward;
+        constexpr double kOpponentTerm = Reflector::s_sucker - Reflector::s_reward;
+        constexpr double kBothTerm = Reflector::s_punishment - Reflector::s_sucker - Reflector::s_temptation + Reflector::s_reward;
+    }
+
+    void ReflectorBatch::reset(std::size_t lanes) {
+        m_trust.assign(lanes, 0.5);
+        m_mood.assign(lanes, 0.0);
+        m_expectedReward.assign(lanes, Reflector::s_reward);
+        m_selfDefected.resize(lanes);
+        m_opponentDefected.resize(lanes);
+        m_thresholds.resize(lanes);
+    }
+
+    std::size_t ReflectorBatch::size() const {
+        return m_trust.size();
+    }
+
+    void ReflectorBatch::observe(std::uint64_t lastSelf, std::uint64_t lastOpponent) {
+        const std::size_t lanes = m_trust.size();
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            m_selfDefected[lane] = static_cast<double>((lastSelf >> lane) & 1u);
+            m_opponentDefected[lane] = static_cast<double>((lastOpponent >> lane) & 1u);
+        }
+
+        const double* selfDefected = m_selfDefected.data();
+        const double* opponentDefected = m_opponentDefected.data();
+        double* trust = m_trust.data();
+        double* mood = m_mood.data();
+        double* expected = m_expectedReward.data();
+        std::size_t lane = 0;
+
+#if IPD_REFLECTOR_SSE2
+        // Two lanes per register. max/min take the bound first so ties and signed zeros resolve
+        // exactly like std::max/std::min below, and no multiply-add is fused (see FpContract.h,
+        // also included by Reflector.cpp): the lanes must round like the scalar Reflector.
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d one = _mm_set1_pd(1.0);
+        const __m128d minusOne = _mm_set1_pd(-1.0);
+        const __m128d eta = _mm_set1_pd(kEta);
+        const __m128d alpha = _mm_set1_pd(Reflector::s_alpha);
+        const __m128d beta = _mm_set1_pd(Reflector::s_beta);
+        for (; lane + 2 <= lanes; lane += 2) {
+            const __m128d self = _mm_loadu_pd(selfDefected + lane);
+            const __m128d opponent = _mm_loadu_pd(opponentDefected + lane);
+            const __m128d payoff = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_set1_pd(Reflector::s_reward),
+                _mm_mul_pd(_mm_set1_pd(kSelfTerm), self)),
+                _mm_mul_pd(_mm_set1_pd(kOpponentTerm), opponent)),
+                _mm_mul_pd(_mm_set1_pd(kBothTerm), _mm_mul_pd(self, opponent)));
+
+            const __m128d moodNow = _mm_loadu_pd(mood + lane);
+            const __m128d expectedNow = _mm_loadu_pd(expected + lane);
+            const __m128d better = _mm_cmpgt_pd(payoff, expectedNow);
+            const __m128d shifted = _mm_or_pd(_mm_and_pd(better, _mm_add_pd(moodNow, alpha)),
+                _mm_andnot_pd(better, _mm_sub_pd(moodNow, beta)));
+            const __m128d nextMood = _mm_min_pd(one, _mm_max_pd(minusOne, shifted));
+            const __m128d learningRate = _mm_max_pd(zero, _mm_mul_pd(eta, _mm_add_pd(one, nextMood)));
+
+            const __m128d trustNow = _mm_loadu_pd(trust + lane);
+            const __m128d towardsOne = _mm_add_pd(trustNow, _mm_mul_pd(learningRate, _mm_sub_pd(one, trustNow)));
+            const __m128d towardsZero = _mm_sub_pd(trustNow, _mm_mul_pd(learningRate, trustNow));
+            const __m128d betrayed = _mm_cmpneq_pd(opponent, zero);
+            const __m128d nextTrust = _mm_or_pd(_mm_and_pd(betrayed, towardsZero), _mm_andnot_pd(betrayed, towardsOne));
+
+            _mm_storeu_pd(mood + lane, nextMood);
+            _mm_storeu_pd(trust + lane, _mm_min_pd(one, _mm_max_pd(zero, nextTrust)));
+            _mm_storeu_pd(expected + lane, _mm_add_pd(expectedNow, _mm_mul_pd(eta, _mm_sub_pd(payoff, expectedNow))));
+        }
+#endif
+
+        for (; lane < lanes; ++lane) {
+            const double payoff = Reflector::s_reward + kSelfTerm * selfDefected[lane] + kOpponentTerm * opponentDefected[lane]
+                + kBothTerm * (selfDefected[lane] * opponentDefected[lane]);
+
+            const double shifted = payoff > expected[lane] ? mood[lane] + Reflector::s_alpha : mood[lane] - Reflector::s_beta;
+            const double nextMood = std::min(std::max(shifted, -1.0), 1.0);
+            const double learningRate = std::max(kEta * (1.0 + nextMood), 0.0);
+            const double nextTrust = opponentDefected[lane] != 0.0
+                ? trust[lane] - learningRate * trust[lane]
+                : trust[lane] + learningRate * (1.0 - trust[lane]);
+
+            mood[lane] = nextMood;
+            trust[lane] = std::min(std::max(nextTrust, 0.0), 1.0);
+            expected[lane] += kEta * (payoff - expected[lane]);
+        }
+    }
+
+    std::uint64_t ReflectorBatch::decide(std::vector<Random>& streams) {
+        const std::size_t lanes = m_trust.size();
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            m_thresholds[lane] = Probability(m_trust[lane]).threshold();
+        }
+        // Random::nextBool(Probability) on a per-match stream: cooperate below the threshold.
+        std::uint64_t defects = 0;
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            if ((streams[lane].nextBits() >> 11) >= m_thresholds[lane]) {
+                defects |= static_cast<std::uint64_t>(1) << lane;
+            }
+        }
+        return defects;
+    }
+
+    double ReflectorBatch::trust(std::size_t lane) const {
+        return m_trust[lane];
+    }
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Random.h"
+
+namespace ipd {
+    // Structure-of-arrays Reflector: up to 64 independent instances ("lanes"), one per bit of
+    // the move masks (a set bit means Defect). Lane i evolves exactly like a scalar Reflector
+    // seeing the same history and drawing from the same stream: the update uses the same
+    // operations in the same order, only as branch-free selects over flat arrays (two lanes
+    // per SSE2 register where available).
+    class ReflectorBatch {
+    public:
+        // Back to the initial trust, mood and expected reward, with `lanes` active lanes.
+        void reset(std::size_t lanes);
+        std::size_t size() const;
+
+        // Learning update from the last recorded round of every lane.
+        void observe(std::uint64_t lastSelf, std::uint64_t lastOpponent);
+        // Draws every lane's move from its own stream, as Reflector::nextMove does.
+        std::uint64_t decide(std::vector<Random>& streams);
+
+        double trust(std::size_t lane) const;
+
+    private:
+        std::vector<double> m_trust;
+        std::vector<double> m_mood;
+        std::vector<double> m_expectedReward;
+        std::vector<double> m_selfDefected;     // last round's moves as 0/1
+        std::vector<double> m_opponentDefected;
+        std::vector<std::uint64_t> m_thresholds;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include "ReplicatorDynamics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace ipd {
+    namespace {
+        constexpr double kAbsoluteTolerance = 1e-10;
+        constexpr double kRelativeTolerance = 1e-8;
+        constexpr double kMinimumStep = 1e-12;
+
+        // Dormand-Prince 5(4) tableau. Row s holds the weights of stages 0..s-1 for stage s;
+        // the last row is also the fifth-order solution, whose derivative is stage 6.
+        constexpr double kDormandPrince[7][6] = {
+            { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+            { 1.0 / 5.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+            { 3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0, 0.0 },
+            { 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0, 0.0 },
+            { 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0.0, 0.0 },
+            { 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0, 0.0 },
+            { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0 }
+        };
+        // Fifth- minus fourth-order weights: the local error estimate.
+        constexpr double kDormandPrinceError[7] = {
+            71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0
+        };
+
+        // Integration error can push a share slightly below zero or the total off one.
+        void normalise(std::vector<double>& shares) {
+            double total = 0.0;
+            for (double& share : shares) {
+                share = std::max(share, 0.0);
+                total += share;
+            }
+            if (total > 0.0) {
+                for (double& share : shares) {
+                    share /= total;
+                }
+            }
+        }
+    }
+
+    Integrator integratorFromName(const std::string& name) {
+        if (name == "rk4") {
+            return Integrator::Rk4;
+        }
+        if (name == "adaptive") {
+            return Integrator::Adaptive;
+        }
+        throw std::runtime_error("Unknown integrator: " + name);
+    }
+
+    ReplicatorDynamics::ReplicatorDynamics(std::vector<double> payoffs, std::vector<double> costs, double mutationRate, Integrator integrator, double step)
+        : m_size(costs.size())
+        , m_payoffs(std::move(payoffs))
+        , m_costs(std::move(costs))
+        , m_mutationRate(mutationRate)
+        , m_integrator(integrator)
+        , m_step(step)
+        , m_fitness(m_size)
+        , m_point(m_size)
+        , m_next(m_size) {
+        if (m_payoffs.size() != m_size * m_size) {
+            throw std::runtime_error("Replicator payoff matrix does not match the number of strategies.");
+        }
+        if (!(m_step > 0.0)) {
+            throw std::runtime_error("Replicator step must be positive.");
+        }
+        for (auto& stage : m_stages) {
+            stage.resize(m_size);
+        }
+    }
+
+    void ReplicatorDynamics::derivative(const std::vector<double>& shares, std::vector<double>& rates) {
+        double meanFitness = 0.0;
+        for (std::size_t row = 0; row < m_size; ++row) {
+            const double* payoffRow = m_payoffs.data() + row * m_size;
+            double payoff = 0.0;
+            for (std::size_t column = 0; column < m_size; ++column) {
+                payoff += payoffRow[column] * shares[column];
+            }
+            m_fitness[row] = payoff - m_costs[row];
+            meanFitness += shares[row] * m_fitness[row];
+        }
+        const double mutation = m_size > 1 ? m_mutationRate : 0.0;
+        const double spread = m_size > 1 ? 1.0 / static_cast<double>(m_size - 1) : 0.0;
+        for (std::size_t index = 0; index < m_size; ++index) {
+            rates[index] = shares[index] * (m_fitness[index] - meanFitness)
+                + mutation * ((1.0 - shares[index]) * spread - shares[index]);
+        }
+    }
+
+    void ReplicatorDynamics::stage(const std::vector<double>& shares, double h, const double* coefficients, std::size_t count, std::vector<double>& out) const {
+        std::copy(shares.begin(), shares.end(), out.begin());
+        for (std::size_t s = 0; s < count; ++s) {
+            const double weight = h * coefficients[s];
+            if (weight == 0.0) {
+                continue;
+            }
+            const std::vector<double>& slope = m_stages[s];
+            for (std::size_t index = 0; index < m_size; ++index) {
+                out[index] += weight * slope[index];
+            }
+        }
+    }
+
+    void ReplicatorDynamics::stepRk4(std::vector<double>& shares, double h) {
+        static constexpr double kHalf[1] = { 0.5 };
+        static constexpr double kSecondHalf[2] = { 0.0, 0.5 };
+        static constexpr double kFull[3] = { 0.0, 0.0, 1.0 };
+        static constexpr double kFinal[4] = { 1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0 };
+
+        derivative(shares, m_stages[0]);
+        stage(shares, h, kHalf, 1, m_point);
+        derivative(m_point, m_stages[1]);
+        stage(shares, h, kSecondHalf, 2, m_point);
+        derivative(m_point, m_stages[2]);
+        stage(shares, h, kFull, 3, m_point);
+        derivative(m_point, m_stages[3]);
+        stage(shares, h, kFinal, 4, m_next);
+        shares.swap(m_next);
+    }
+
+    double ReplicatorDynamics::stepDormandPrince(const std::vector<double>& shares, double h, std::vector<double>& next) {
+        derivative(shares, m_stages[0]);
+        for (std::size_t s = 1; s < 6; ++s) {
+            stage(shares, h, kDormandPrince[s], s, m_point);
+            derivative(m_point, m_stages[s]);
+        }
+        stage(shares, h, kDormandPrince[6], 6, next);
+        derivative(next, m_stages[6]);
+
+        double error = 0.0;
+        for (std::size_t index = 0; index < m_size; ++index) {
+            double estimate = 0.0;
+            for (std::size_t s = 0; s < 7; ++s) {
+                estimate += kDormandPrinceError[s] * m_stages[s][index];
+            }
+            const double scale = kAbsoluteTolerance + kRelativeTolerance * std::max(std::abs(shares[index]), std::abs(next[index]));
+            error = std::max(error, std::abs(h * estimate) / scale);
+        }
+        return error;
+    }
+
+    void ReplicatorDynamics::advance(std::vector<double>& shares, double duration) {
+        if (shares.size() != m_size || duration <= 0.0) {
+            return;
+        }
+
+        if (m_integrator == Integrator::Rk4) {
+            const auto steps = std::max<long long>(1, static_cast<long long>(std::ceil(duration / m_step - 1e-9)));
+            const double h = duration / static_cast<double>(steps);
+            for (long long step = 0; step < steps; ++step) {
+                stepRk4(shares, h);
+                normalise(shares);
+            }
+            return;
+        }
+
+        // Standard step-size controller: grow or shrink by 0.9 * error^(-1/5), within [0.2, 5].
+        // A step cut short to land on `duration` does not shrink the step carried forward.
+        double elapsed = 0.0;
+        while (duration - elapsed > duration * 1e-12) {
+            const double h = std::min(m_step, duration - elapsed);
+            const double error = stepDormandPrince(shares, h, m_next);
+            const bool accepted = error <= 1.0;
+            if (accepted) {
+                shares.swap(m_next);
+                normalise(shares);
+                elapsed += h;
+            }
+            const double factor = error > 0.0 ? std::clamp(0.9 * std::pow(error, -0.2), 0.2, 5.0) : 5.0;
+            const double proposed = h * factor;
+            if (!accepted || proposed < m_step || h >= m_step) {
+                m_step = proposed;
+            }
+            if (m_step < kMinimumStep) {
+                throw std::runtime_error("Replicator integration step underflow.");
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ipd {
+    enum class Integrator {
+        Rk4,     // classic fourth-order Runge-Kutta with a fixed step
+        Adaptive // Dormand-Prince 5(4) with embedded error control
+    };
+
+    Integrator integratorFromName(const std::string& name);
+
+    // Replicator-mutator equation over strategy shares x (summing to one):
+    //   dx_i/dt = x_i (f_i - sum_j x_j f_j) + mu ((1 - x_i) / (n - 1) - x_i),   f = A x - c
+    // A is the row-vs-column payoff matrix, c the per-strategy cost (SCB cost plus complexity
+    // penalty) and mu the rate at which a strategy turns into a uniformly chosen other one.
+    class ReplicatorDynamics {
+    public:
+        ReplicatorDynamics(std::vector<double> payoffs, std::vector<double> costs, double mutationRate, Integrator integrator, double step);
+
+        // Advances `shares` by `duration` time units; they stay non-negative and sum to one.
+        void advance(std::vector<double>& shares, double duration);
+
+    private:
+        void derivative(const std::vector<double>& shares, std::vector<double>& rates);
+        void stepRk4(std::vector<double>& shares, double h);
+        // Attempts one step of size h; returns the scaled error estimate (accepted when <= 1).
+        double stepDormandPrince(const std::vector<double>& shares, double h, std::vector<double>& next);
+        void stage(const std::vector<double>& shares, double h, const double* coefficients, std::size_t count, std::vector<double>& out) const;
+
+        std::size_t m_size;
+        std::vector<double> m_payoffs; // row-major m_size x m_size
+        std::vector<double> m_costs;
+        double m_mutationRate;
+        Integrator m_integrator;
+        double m_step; // fixed RK4 step, or the adaptive integrator's current step
+
+        // Scratch buffers reused across steps.
+        std::vector<double> m_fitness;
+        std::vector<double> m_point;
+        std::vector<double> m_next;
+        std::array<std::vector<double>, 7> m_stages;
+    };
+}
\ No newline at end of file
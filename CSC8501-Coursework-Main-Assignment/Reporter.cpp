@@ -1,6 +1,8 @@
 #include "Reporter.h"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <cmath>
@@ -52,6 +54,20 @@ namespace ipd {
             return s.str();
         }
 
+        // "NA" marks a strategy whose CI was still wider than --ci-target at --max-repeats.
+        std::string formatRepeatsNeededCell(const Result& r) {
+            return r.repeatsNeeded ? std::to_string(*r.repeatsNeeded) : std::string("NA");
+        }
+
+        std::string formatEchoLengthCell(const Result& r) {
+            if (!r.echoLength) {
+                return "NA";
+            }
+            std::ostringstream s;
+            s << std::fixed << std::setprecision(3) << *r.echoLength;
+            return s.str();
+        }
+
         std::string formatCostValue(double cost) {
             std::ostringstream s;
             s << static_cast<int>(std::llround(cost));
@@ -145,9 +161,7 @@ namespace ipd {
                     return formatFirstDefectionCell(r);
                 } },
                 { "EchoLen", 12, false, [](const Result& r) {
-                    std::ostringstream s;
-                    s << std::fixed << std::setprecision(3) << r.echoLength;
-                    return s.str();
+                    return formatEchoLengthCell(r);
                 } },
                 { "Complexity", 12, false, [](const Result& r) {
                     std::ostringstream s;
@@ -167,6 +181,11 @@ namespace ipd {
                 } }
             };
             columns.insert(columns.end(), tail.begin(), tail.end());
+            if (config.ciTarget > 0.0) {
+                columns.push_back({ "Repeats", 8, false, [](const Result& r) {
+                    return formatRepeatsNeededCell(r);
+                } });
+            }
             return columns;
         }
         int tableWidth(const ColumnList& columns) {
@@ -218,7 +237,10 @@ namespace ipd {
             buffer << "Seed=" << (config.useSeed ? std::to_string(config.seed) : std::string("random"));
             buffer << ", Epsilon=" << std::fixed << std::setprecision(3) << config.epsilon;
             buffer << ", Payoffs=" << formatPayoffs(config.payoffs) << '\n';
-            buffer << "Rounds=" << config.rounds << ", Repeats=" << config.repeats;
+            buffer << "Rounds=" << config.rounds << ", Repeats=" << (results.empty() ? config.repeats : results.front().repeats);
+            if (config.ciTarget > 0.0) {
+                buffer << " (CI target " << std::fixed << std::setprecision(3) << config.ciTarget << ')';
+            }
             if (config.evolve) {
                 buffer << ", Generations=" << config.generations;
             }
@@ -274,7 +296,12 @@ namespace ipd {
             if (config.scbEnabled) {
                 stream << ",net_mean,cost";
             }
-            stream << ",stdev,ci95_low,ci95_high,coop_rate,first_defection,echo_length,repeats,seed,epsilon,payoffs,complexity,samples,share\n";
+            stream << ",stdev,ci95_low,ci95_high,coop_rate,first_defection,echo_length,repeats";
+            if (config.ciTarget > 0.0) {
+                stream << ",repeats_needed";
+            }
+            // Quantiles come last so the columns older readers index by position stay put.
+            stream << ",seed,epsilon,payoffs,complexity,samples,share,p05,p50,p95\n";
             const std::string payoffs = std::to_string(config.payoffs.T) + ',' + std::to_string(config.payoffs.R) + ',' +
                 std::to_string(config.payoffs.P) + ',' + std::to_string(config.payoffs.S);
             for (const auto& result : results) {
@@ -293,14 +320,26 @@ namespace ipd {
                 else {
                     stream << "NA";
                 }
-                stream << ',' << result.echoLength << ','
-                    << config.repeats << ','
-                    << (config.useSeed ? std::to_string(config.seed) : std::string()) << ','
+                stream << ',';
+                if (result.echoLength) {
+                    stream << *result.echoLength;
+                }
+                else {
+                    stream << "NA";
+                }
+                stream << ',' << result.repeats << ',';
+                if (config.ciTarget > 0.0) {
+                    stream << formatRepeatsNeededCell(result) << ',';
+                }
+                stream << (config.useSeed ? std::to_string(config.seed) : std::string()) << ','
                     << config.epsilon << ','
                     << '"' << payoffs << '"' << ','
                     << result.complexity << ','
                     << result.samples << ','
-                    << result.extra << '\n';
+                    << result.extra << ','
+                    << result.p05 << ','
+                    << result.p50 << ','
+                    << result.p95 << '\n';
             }
         }
 
@@ -339,7 +378,10 @@ namespace ipd {
             stream << "{\n";
             stream << "  \"meta\": {\n";
             stream << "    \"rounds\": " << config.rounds << ",\n";
-            stream << "    \"repeats\": " << config.repeats << ",\n";
+            stream << "    \"repeats\": " << (results.empty() ? config.repeats : results.front().repeats) << ",\n";
+            if (config.ciTarget > 0.0) {
+                stream << "    \"ci_target\": " << config.ciTarget << ",\n";
+            }
             stream << "    \"epsilon\": " << config.epsilon << ",\n";
             stream << "    \"payoffs\": [" << config.payoffs.T << ',' << config.payoffs.R << ',' << config.payoffs.P << ',' << config.payoffs.S << "],\n";
             stream << "    \"seed\": " << (config.useSeed ? std::to_string(config.seed) : "null") << ",\n";
@@ -365,6 +407,9 @@ namespace ipd {
                 stream << "      \"stdev\": " << result.stdev << ",\n";
                 stream << "      \"ci95_low\": " << result.ciLow << ",\n";
                 stream << "      \"ci95_high\": " << result.ciHigh << ",\n";
+                stream << "      \"p05\": " << result.p05 << ",\n";
+                stream << "      \"p50\": " << result.p50 << ",\n";
+                stream << "      \"p95\": " << result.p95 << ",\n";
                 stream << "      \"coop_rate\": " << result.coopRate << ",\n";
                 stream << "      \"first_defection\": ";
                 if (result.firstDefection) {
@@ -374,11 +419,21 @@ namespace ipd {
                     stream << "null";
                 }
                 stream << ",\n";
-                stream << "      \"echo_length\": " << result.echoLength << ",\n";
+                stream << "      \"echo_length\": ";
+                if (result.echoLength) {
+                    stream << *result.echoLength;
+                }
+                else {
+                    stream << "null";
+                }
+                stream << ",\n";
                 stream << "      \"complexity\": " << result.complexity << ",\n";
                 stream << "      \"samples\": " << result.samples << ",\n";
                 stream << "      \"share\": " << result.extra << ",\n";
-                stream << "      \"repeats\": " << config.repeats << '\n';
+                if (config.ciTarget > 0.0) {
+                    stream << "      \"repeats_needed\": " << (result.repeatsNeeded ? std::to_string(*result.repeatsNeeded) : std::string("null")) << ",\n";
+                }
+                stream << "      \"repeats\": " << result.repeats << '\n';
                 stream << "    }" << (index + 1 == results.size() ? "\n" : ",\n");
             }
             stream << "  ]";
@@ -405,6 +460,273 @@ namespace ipd {
             }
             stream << "}\n";
         }
+
+        // Header row, then one row per strategy; each cell is the row strategy's mean against
+        // the column strategy with its 95% CI half-width.
+        std::string buildTextMatrix(const Config& config, const PayoffMatrix& matrix) {
+            std::size_t width = 17;
+            for (const auto& name : matrix.names) {
+                width = std::max(width, name.size());
+            }
+            const int cellWidth = static_cast<int>(width);
+
+            std::ostringstream buffer;
+            buffer << "Seed=" << (config.useSeed ? std::to_string(config.seed) : std::string("random"));
+            buffer << ", Epsilon=" << std::fixed << std::setprecision(3) << config.epsilon;
+            buffer << ", Payoffs=" << formatPayoffs(config.payoffs) << '\n';
+            buffer << "Rounds=" << config.rounds << ", Repeats=" << matrix.repeats << '\n';
+            buffer << "Mean score of row vs column (+/- 95% CI half-width)\n";
+            buffer << std::left << std::setw(cellWidth) << "" << std::right;
+            for (const auto& name : matrix.names) {
+                buffer << ' ' << std::setw(cellWidth) << name;
+            }
+            buffer << '\n';
+            for (std::size_t row = 0; row < matrix.names.size(); ++row) {
+                buffer << std::left << std::setw(cellWidth) << matrix.names[row] << std::right;
+                for (std::size_t column = 0; column < matrix.names.size(); ++column) {
+                    const PayoffCell& cell = matrix.at(row, column);
+                    std::ostringstream value;
+                    value << std::fixed << std::setprecision(3) << cell.mean << "+/-" << (cell.ciHigh - cell.ciLow) / 2.0;
+                    buffer << ' ' << std::setw(cellWidth) << value.str();
+                }
+                buffer << '\n';
+            }
+            return buffer.str();
+        }
+
+        void writeCsvMatrix(const Config& config, const PayoffMatrix& matrix) {
+            std::ofstream file;
+            std::ostream& stream = prepareStream(config, file);
+            stream << "row,column,mean,ci95_low,ci95_high,samples\n";
+            for (std::size_t row = 0; row < matrix.names.size(); ++row) {
+                for (std::size_t column = 0; column < matrix.names.size(); ++column) {
+                    const PayoffCell& cell = matrix.at(row, column);
+                    stream << '"' << matrix.names[row] << "\",\"" << matrix.names[column] << "\","
+                        << std::fixed << std::setprecision(6) << cell.mean << ','
+                        << cell.ciLow << ','
+                        << cell.ciHigh << ','
+                        << cell.samples << '\n';
+                }
+            }
+        }
+
+        void appendJsonGrid(std::ostream& stream, const PayoffMatrix& matrix, const char* key, double PayoffCell::* field, bool last) {
+            stream << "  \"" << key << "\": [\n";
+            for (std::size_t row = 0; row < matrix.names.size(); ++row) {
+                stream << "    [";
+                for (std::size_t column = 0; column < matrix.names.size(); ++column) {
+                    if (column != 0) {
+                        stream << ',';
+                    }
+                    stream << matrix.at(row, column).*field;
+                }
+                stream << ']' << (row + 1 == matrix.names.size() ? "\n" : ",\n");
+            }
+            stream << "  ]" << (last ? "\n" : ",\n");
+        }
+
+        void writeJsonMatrix(const Config& config, const PayoffMatrix& matrix) {
+            std::ofstream file;
+            std::ostream& stream = prepareStream(config, file);
+            stream << "{\n";
+            stream << "  \"meta\": {\n";
+            stream << "    \"rounds\": " << config.rounds << ",\n";
+            stream << "    \"repeats\": " << matrix.repeats << ",\n";
+            stream << "    \"epsilon\": " << config.epsilon << ",\n";
+            stream << "    \"payoffs\": [" << config.payoffs.T << ',' << config.payoffs.R << ',' << config.payoffs.P << ',' << config.payoffs.S << "],\n";
+            stream << "    \"seed\": " << (config.useSeed ? std::to_string(config.seed) : "null") << '\n';
+            stream << "  },\n";
+            stream << "  \"strategies\": " << strategyArray(matrix.names) << ",\n";
+            appendJsonGrid(stream, matrix, "mean", &PayoffCell::mean, false);
+            appendJsonGrid(stream, matrix, "ci95_low", &PayoffCell::ciLow, false);
+            appendJsonGrid(stream, matrix, "ci95_high", &PayoffCell::ciHigh, true);
+            stream << "}\n";
+        }
+
+        template <typename T>
+        void writeBinary(std::ostream& stream, T value) {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        std::ofstream openBinaryStream(const Config& config) {
+            namespace fs = std::filesystem;
+            fs::path path(config.outputFile);
+            if (!path.parent_path().empty() && !fs::exists(path.parent_path())) {
+                fs::create_directories(path.parent_path());
+            }
+            std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            if (!stream) {
+                throw std::runtime_error("Unable to open output file: " + path.string());
+            }
+            return stream;
+        }
+
+        // IPDM layout, host byte order (little-endian on every supported target):
+        //   char[4] "IPDM", uint32 version (1), uint32 N, uint32 rounds, uint32 repeats,
+        //   N x { uint32 length, char[length] name },
+        //   N*N x { float64 mean, float64 ci95_low, float64 ci95_high, uint64 samples }, row-major.
+        void writeBinaryMatrix(const Config& config, const PayoffMatrix& matrix) {
+            std::ofstream stream = openBinaryStream(config);
+            stream.write("IPDM", 4);
+            writeBinary<std::uint32_t>(stream, 1);
+            writeBinary(stream, static_cast<std::uint32_t>(matrix.names.size()));
+            writeBinary(stream, static_cast<std::uint32_t>(config.rounds));
+            writeBinary(stream, static_cast<std::uint32_t>(matrix.repeats));
+            for (const auto& name : matrix.names) {
+                writeBinary(stream, static_cast<std::uint32_t>(name.size()));
+                stream.write(name.data(), static_cast<std::streamsize>(name.size()));
+            }
+            for (const auto& cell : matrix.cells) {
+                writeBinary(stream, cell.mean);
+                writeBinary(stream, cell.ciLow);
+                writeBinary(stream, cell.ciHigh);
+                writeBinary(stream, static_cast<std::uint64_t>(cell.samples));
+            }
+            if (!stream) {
+                throw std::runtime_error("Unable to write output file: " + config.outputFile);
+            }
+        }
+
+        // Points of interest shown by the text landscape; all of them lie on every grid, since
+        // the grid always includes 0 and 1.
+        struct Landmark {
+            const char* name;
+            std::array<double, 4> cooperate;
+        };
+
+        constexpr Landmark kLandmarks[] = {
+            { "ALLC", { 1.0, 1.0, 1.0, 1.0 } },
+            { "ALLD", { 0.0, 0.0, 0.0, 0.0 } },
+            { "TFT", { 1.0, 0.0, 1.0, 0.0 } },
+            { "GRIM", { 1.0, 0.0, 0.0, 0.0 } },
+            { "PAVLOV", { 1.0, 0.0, 0.0, 1.0 } },
+        };
+        constexpr std::size_t kLandscapeTop = 10;
+
+        std::string formatProbabilities(const std::array<double, 4>& cooperate) {
+            std::ostringstream stream;
+            stream << std::fixed << std::setprecision(3) << '(' << cooperate[0] << ',' << cooperate[1] << ',' << cooperate[2] << ',' << cooperate[3] << ')';
+            return stream.str();
+        }
+
+        std::size_t landscapeIndex(const Landscape& landscape, const std::array<double, 4>& cooperate) {
+            std::size_t index = 0;
+            for (const double probability : cooperate) {
+                index = index * static_cast<std::size_t>(landscape.resolution)
+                    + static_cast<std::size_t>(std::lround(probability * (landscape.resolution - 1)));
+            }
+            return index;
+        }
+
+        // Header, the best points by net score, then where the classic memory-one strategies
+        // sit: their scores and rank among all points.
+        std::string buildTextLandscape(const Config& config, const Landscape& landscape) {
+            std::vector<std::size_t> order(landscape.points.size());
+            std::iota(order.begin(), order.end(), std::size_t{ 0 });
+            std::stable_sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+                return landscape.points[lhs].net > landscape.points[rhs].net;
+            });
+            std::vector<std::size_t> rank(order.size());
+            for (std::size_t position = 0; position < order.size(); ++position) {
+                rank[order[position]] = position + 1;
+            }
+
+            std::ostringstream buffer;
+            buffer << "Seed=" << (config.useSeed ? std::to_string(config.seed) : std::string("random"));
+            buffer << ", Epsilon=" << std::fixed << std::setprecision(3) << config.epsilon;
+            buffer << ", Payoffs=" << formatPayoffs(config.payoffs) << '\n';
+            buffer << "Rounds=" << config.rounds << ", Repeats=" << landscape.repeats << ", Grid=" << landscape.resolution << "^4 ("
+                << landscape.points.size() << " points)\n";
+            buffer << "Field: ";
+            for (std::size_t index = 0; index < landscape.field.size(); ++index) {
+                buffer << (index == 0 ? "" : ", ") << landscape.field[index];
+            }
+            buffer << '\n';
+
+            auto row = [&](const std::string& label, std::size_t index) {
+                const LandscapePoint& point = landscape.points[index];
+                buffer << std::left << std::setw(10) << label << std::right << std::setw(32) << formatProbabilities(point.cooperate)
+                    << std::setw(12) << std::fixed << std::setprecision(3) << point.mean
+                    << std::setw(12) << point.net
+                    << std::setw(10) << rank[index] << '\n';
+            };
+            auto header = [&](const std::string& title) {
+                buffer << '\n' << title << '\n';
+                buffer << std::left << std::setw(10) << "" << std::right << std::setw(32) << "(pCC,pCD,pDC,pDD)"
+                    << std::setw(12) << "Mean" << std::setw(12) << "Net" << std::setw(10) << "Rank" << '\n';
+            };
+
+            header("Best points by net score");
+            for (std::size_t position = 0; position < std::min(kLandscapeTop, order.size()); ++position) {
+                row("#" + std::to_string(position + 1), order[position]);
+            }
+            header("Classic strategies");
+            for (const Landmark& landmark : kLandmarks) {
+                row(landmark.name, landscapeIndex(landscape, landmark.cooperate));
+            }
+            return buffer.str();
+        }
+
+        void writeCsvLandscape(const Config& config, const Landscape& landscape) {
+            std::ofstream file;
+            std::ostream& stream = prepareStream(config, file);
+            stream << "pCC,pCD,pDC,pDD,mean,net\n";
+            for (const auto& point : landscape.points) {
+                stream << std::fixed << std::setprecision(6) << point.cooperate[0] << ',' << point.cooperate[1] << ','
+                    << point.cooperate[2] << ',' << point.cooperate[3] << ','
+                    << point.mean << ',' << point.net << '\n';
+            }
+        }
+
+        void writeJsonLandscape(const Config& config, const Landscape& landscape) {
+            std::ofstream file;
+            std::ostream& stream = prepareStream(config, file);
+            stream << "{\n";
+            stream << "  \"meta\": {\n";
+            stream << "    \"rounds\": " << config.rounds << ",\n";
+            stream << "    \"repeats\": " << landscape.repeats << ",\n";
+            stream << "    \"resolution\": " << landscape.resolution << ",\n";
+            stream << "    \"epsilon\": " << config.epsilon << ",\n";
+            stream << "    \"payoffs\": [" << config.payoffs.T << ',' << config.payoffs.R << ',' << config.payoffs.P << ',' << config.payoffs.S << "],\n";
+            stream << "    \"seed\": " << (config.useSeed ? std::to_string(config.seed) : "null") << '\n';
+            stream << "  },\n";
+            stream << "  \"field\": " << strategyArray(landscape.field) << ",\n";
+            stream << "  \"columns\": [\"pCC\",\"pCD\",\"pDC\",\"pDD\",\"mean\",\"net\"],\n";
+            stream << "  \"points\": [\n";
+            for (std::size_t index = 0; index < landscape.points.size(); ++index) {
+                const LandscapePoint& point = landscape.points[index];
+                stream << "    [" << point.cooperate[0] << ',' << point.cooperate[1] << ',' << point.cooperate[2] << ',' << point.cooperate[3]
+                    << ',' << point.mean << ',' << point.net << ']' << (index + 1 == landscape.points.size() ? "\n" : ",\n");
+            }
+            stream << "  ]\n";
+            stream << "}\n";
+        }
+
+        // IPDL layout, host byte order like IPDM:
+        //   char[4] "IPDL", uint32 version (1), uint32 resolution R, uint32 rounds, uint32 repeats,
+        //   uint32 F, F x { uint32 length, char[length] name },
+        //   R^4 x { float64 mean, float64 net }, row-major with pCC slowest; point (a,b,c,d) has
+        //   probabilities (a,b,c,d) / (R - 1).
+        void writeBinaryLandscape(const Config& config, const Landscape& landscape) {
+            std::ofstream stream = openBinaryStream(config);
+            stream.write("IPDL", 4);
+            writeBinary<std::uint32_t>(stream, 1);
+            writeBinary(stream, static_cast<std::uint32_t>(landscape.resolution));
+            writeBinary(stream, static_cast<std::uint32_t>(config.rounds));
+            writeBinary(stream, static_cast<std::uint32_t>(landscape.repeats));
+            writeBinary(stream, static_cast<std::uint32_t>(landscape.field.size()));
+            for (const auto& name : landscape.field) {
+                writeBinary(stream, static_cast<std::uint32_t>(name.size()));
+                stream.write(name.data(), static_cast<std::streamsize>(name.size()));
+            }
+            for (const auto& point : landscape.points) {
+                writeBinary(stream, point.mean);
+                writeBinary(stream, point.net);
+            }
+            if (!stream) {
+                throw std::runtime_error("Unable to write output file: " + config.outputFile);
+            }
+        }
     }
 
     void reportResults(const Config& config, const std::vector<Result>& results, const std::vector<GenerationShare>& history) {
@@ -425,4 +747,124 @@ namespace ipd {
             stream << report;
         }
     }
+
+    void reportReplay(const Config& config, const MatchReplay& replay) {
+        std::ofstream file;
+        std::ostream& stream = prepareStream(config, file);
+        const auto history = replay.report.trace ? replay.report.trace->history() : std::vector<MatchState::Round>{};
+
+        if (config.outputFormat == "csv") {
+            stream << "round,first,second\n";
+            for (std::size_t index = 0; index < history.size(); ++index) {
+                stream << index + 1 << ',' << history[index].first << ',' << history[index].second << '\n';
+            }
+            return;
+        }
+
+        std::string movesFirst;
+        std::string movesSecond;
+        movesFirst.reserve(history.size());
+        movesSecond.reserve(history.size());
+        for (const auto& round : history) {
+            movesFirst += toString(round.first);
+            movesSecond += toString(round.second);
+        }
+
+        if (config.outputFormat == "json") {
+            stream << "{\n";
+            stream << "  \"repeat\": " << replay.repeat << ",\n";
+            stream << "  \"pair\": " << replay.pairIndex << ",\n";
+            stream << "  \"first\": \"" << escapeJson(replay.first) << "\",\n";
+            stream << "  \"second\": \"" << escapeJson(replay.second) << "\",\n";
+            stream << "  \"score_first\": " << replay.report.scoreFirst << ",\n";
+            stream << "  \"score_second\": " << replay.report.scoreSecond << ",\n";
+            stream << "  \"moves_first\": \"" << movesFirst << "\",\n";
+            stream << "  \"moves_second\": \"" << movesSecond << "\"\n";
+            stream << "}\n";
+            return;
+        }
+
+        stream << "Replay repeat=" << replay.repeat << ", pair=" << replay.pairIndex
+            << ": " << replay.first << " vs " << replay.second << '\n';
+        stream << "Score=" << std::fixed << std::setprecision(3) << replay.report.scoreFirst
+            << " / " << replay.report.scoreSecond << '\n';
+        stream << replay.first << ": " << movesFirst << '\n';
+        stream << replay.second << ": " << movesSecond << '\n';
+    }
+
+    void reportMatrix(const Config& config, const PayoffMatrix& matrix) {
+        if (config.outputFormat == "binary") {
+            writeBinaryMatrix(config, matrix);
+            return;
+        }
+        if (config.outputFormat == "csv") {
+            writeCsvMatrix(config, matrix);
+            return;
+        }
+        if (config.outputFormat == "json") {
+            writeJsonMatrix(config, matrix);
+            return;
+        }
+        const std::string report = buildTextMatrix(config, matrix);
+        std::cout << report;
+        std::cout.flush();
+        if (!config.outputFile.empty()) {
+            std::ofstream file;
+            std::ostream& stream = prepareStream(config, file);
+            stream << report;
+        }
+    }
+
+    void reportLandscape(const Config& config, const Landscape& landscape) {
+        if (config.outputFormat == "binary") {
+            writeBinaryLandscape(config, landscape);
+            return;
+        }
+        if (config.outputFormat == "csv") {
+            writeCsvLandscape(config, landscape);
+            return;
+        }
+        if (config.outputFormat == "json") {
+            writeJsonLandscape(config, landscape);
+            return;
+        }
+        const std::string report = buildTextLandscape(config, landscape);
+        std::cout << report;
+        std::cout.flush();
+        if (!config.outputFile.empty()) {
+            std::ofstream file;
+            std::ostream& stream = prepareStream(config, file);
+            stream << report;
+        }
+    }
+
+    void reportBenchmark(const Config& config, const std::vector<SamplingBenchmark>& rows) {
+        std::ofstream file;
+        std::ostream& stream = prepareStream(config, file);
+        if (config.outputFormat == "csv") {
+            stream << "population,generations,seconds_per_generation\n";
+            for (const auto& row : rows) {
+                stream << row.population << ',' << row.generations << ',' << std::scientific << std::setprecision(6) << row.secondsPerGeneration << '\n';
+            }
+            return;
+        }
+        if (config.outputFormat == "json") {
+            stream << "[\n";
+            for (std::size_t index = 0; index < rows.size(); ++index) {
+                const auto& row = rows[index];
+                stream << "  {\"population\": " << row.population << ", \"generations\": " << row.generations
+                    << ", \"seconds_per_generation\": " << std::scientific << std::setprecision(6) << row.secondsPerGeneration << '}'
+                    << (index + 1 == rows.size() ? "\n" : ",\n");
+            }
+            stream << "]\n";
+            return;
+        }
+        stream << "Evolution sampling benchmark (" << config.strategyNames.size() << " strategies, mutation "
+            << std::fixed << std::setprecision(3) << config.mutationRate << ")\n";
+        stream << std::right << std::setw(14) << "Population" << std::setw(14) << "Generations" << std::setw(16) << "us/generation" << '\n';
+        for (const auto& row : rows) {
+            stream << std::setw(14) << row.population << std::setw(14) << row.generations
+                << std::setw(16) << std::fixed << std::setprecision(3) << row.secondsPerGeneration * 1e6 << '\n';
+        }
+    }
 }
\ No newline at end of file
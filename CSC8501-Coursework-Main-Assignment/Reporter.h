@@ -4,8 +4,14 @@
 
 #include "Config.h"
 #include "EvolutionManager.h"
+#include "LandscapeScan.h"
 #include "Result.h"
+#include "TournamentManager.h"
 
 namespace ipd {
     void reportResults(const Config& config, const std::vector<Result>& results, const std::vector<GenerationShare>& history);
+    void reportReplay(const Config& config, const MatchReplay& replay);
+    void reportMatrix(const Config& config, const PayoffMatrix& matrix);
+    void reportLandscape(const Config& config, const Landscape& landscape);
+    void reportBenchmark(const Config& config, const std::vector<SamplingBenchmark>& rows);
 }
\ No newline at end of file
@@ -17,7 +17,13 @@ namespace ipd {
         else {
             stream << "NA";
         }
-        stream << ", echoLength=" << std::fixed << std::setprecision(3) << echoLength;
+        stream << ", echoLength=";
+        if (echoLength) {
+            stream << std::fixed << std::setprecision(3) << *echoLength;
+        }
+        else {
+            stream << "NA";
+        }
         stream << ", complexity=" << std::fixed << std::setprecision(3) << complexity;
         stream << ", cost=" << std::fixed << std::setprecision(3) << cost;
         stream << ", netMean=" << std::fixed << std::setprecision(3) << netMean;
@@ -38,7 +44,11 @@ namespace ipd {
         if (firstDefection) {
             stream << *firstDefection;
         }
-        stream << ',' << echoLength << ','
+        stream << ',';
+        if (echoLength) {
+            stream << *echoLength;
+        }
+        stream << ','
             << complexity << ',' << samples << ',' << extra;
         return stream.str();
     }
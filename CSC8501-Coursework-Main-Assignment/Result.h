@@ -13,14 +13,19 @@ namespace ipd {
         double stdev = 0.0;
         double ciLow = 0.0;
         double ciHigh = 0.0;
+        double p05 = 0.0; // per-match score quantiles (approximate beyond a few hundred samples)
+        double p50 = 0.0;
+        double p95 = 0.0;
         double coopRate = 0.0;
         std::optional<double> firstDefection;
-        double echoLength = 0.0;
+        std::optional<double> echoLength; // empty when the strategy had an exact pairing
         double complexity = 0.0;
         std::size_t samples = 0;
         double cost = 0.0;
         double netMean = 0.0;
         double extra = 0.0; // generic field used by evolution frequency etc.
+        int repeats = 0;       // repeats played by the tournament
+        std::optional<int> repeatsNeeded; // repeats after which this strategy's CI first met --ci-target; empty if it never did
 
         std::string toString() const;
         std::string toCsv() const;
@@ -1,7 +1,9 @@
 #include "Statistics.h"
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <utility>
 
 namespace ipd {
     namespace statistics {
@@ -34,5 +36,160 @@ namespace ipd {
             const double margin = 1.96 * standardError;
             return { meanValue - margin, meanValue + margin };
         }
+
+        void RunningStats::add(double value, double weight) {
+            if (weight <= 0.0) {
+                return;
+            }
+            m_weight += weight;
+            ++m_count;
+            const double delta = value - m_mean;
+            m_mean += delta * (weight / m_weight);
+            m_sumSquares += weight * delta * (value - m_mean);
+        }
+
+        void RunningStats::merge(const RunningStats& other) {
+            if (other.m_weight <= 0.0) {
+                return;
+            }
+            if (m_weight <= 0.0) {
+                *this = other;
+                return;
+            }
+            const double total = m_weight + other.m_weight;
+            const double delta = other.m_mean - m_mean;
+            m_mean += delta * (other.m_weight / total);
+            m_sumSquares += other.m_sumSquares + delta * delta * (m_weight * other.m_weight / total);
+            m_weight = total;
+            m_count += other.m_count;
+        }
+
+        double RunningStats::weight() const {
+            return m_weight;
+        }
+
+        std::size_t RunningStats::count() const {
+            return m_count;
+        }
+
+        double RunningStats::mean() const {
+            return m_mean;
+        }
+
+        // Bessel's correction over the sample count: weight * (n - 1) / n, which is
+        // weight - 1 when every weight is one.
+        double RunningStats::variance() const {
+            if (m_count < 2) {
+                return 0.0;
+            }
+            return m_sumSquares / (m_weight - m_weight / static_cast<double>(m_count));
+        }
+
+        std::tuple<double, double> RunningStats::confidenceInterval95() const {
+            if (m_count < 2) {
+                return { m_mean, m_mean };
+            }
+            const double stdev = std::sqrt(variance());
+            const double standardError = stdev / std::sqrt(static_cast<double>(m_count));
+            const double margin = 1.96 * standardError;
+            return { m_mean - margin, m_mean + margin };
+        }
+
+        QuantileSketch::QuantileSketch(std::size_t k)
+            : m_k(std::max<std::size_t>(k, 8)) {
+            addLevel();
+        }
+
+        std::size_t QuantileSketch::capacity(std::size_t level) const {
+            const std::size_t depth = m_levels.size() - 1 - level;
+            const double scaled = static_cast<double>(m_k) * std::pow(2.0 / 3.0, static_cast<double>(depth));
+            return std::max<std::size_t>(2, static_cast<std::size_t>(scaled));
+        }
+
+        void QuantileSketch::addLevel() {
+            m_levels.emplace_back();
+            m_offsets.push_back(0);
+            m_maxSize = 0;
+            for (std::size_t level = 0; level < m_levels.size(); ++level) {
+                m_maxSize += capacity(level);
+            }
+        }
+
+        void QuantileSketch::add(double value, double weight) {
+            const auto copies = static_cast<std::size_t>(std::llround(std::max(weight, 0.0)));
+            for (std::size_t copy = 0; copy < copies; ++copy) {
+                m_levels[0].push_back(value);
+                ++m_size;
+                if (m_size >= m_maxSize) {
+                    compress();
+                }
+            }
+        }
+
+        void QuantileSketch::merge(const QuantileSketch& other) {
+            while (m_levels.size() < other.m_levels.size()) {
+                addLevel();
+            }
+            for (std::size_t level = 0; level < other.m_levels.size(); ++level) {
+                const auto& items = other.m_levels[level];
+                m_levels[level].insert(m_levels[level].end(), items.begin(), items.end());
+                m_size += items.size();
+            }
+            compress();
+        }
+
+        void QuantileSketch::compress() {
+            while (m_size >= m_maxSize) {
+                std::size_t level = 0;
+                while (m_levels[level].size() < capacity(level)) {
+                    ++level;
+                }
+                compact(level);
+            }
+        }
+
+        // Sorts the level and promotes every other item (weight doubles); an odd item stays behind.
+        void QuantileSketch::compact(std::size_t level) {
+            if (level + 1 == m_levels.size()) {
+                addLevel();
+            }
+            auto& items = m_levels[level];
+            auto& promoted = m_levels[level + 1];
+            std::sort(items.begin(), items.end());
+            const std::size_t pairs = items.size() / 2;
+            const std::size_t offset = m_offsets[level];
+            for (std::size_t pair = 0; pair < pairs; ++pair) {
+                promoted.push_back(items[2 * pair + offset]);
+            }
+            m_offsets[level] ^= 1;
+            items.erase(items.begin(), items.begin() + static_cast<std::ptrdiff_t>(2 * pairs));
+            m_size -= pairs;
+        }
+
+        double QuantileSketch::quantile(double q) const {
+            std::vector<std::pair<double, double>> weighted;
+            weighted.reserve(m_size);
+            double total = 0.0;
+            for (std::size_t level = 0; level < m_levels.size(); ++level) {
+                const double itemWeight = std::ldexp(1.0, static_cast<int>(level));
+                for (double value : m_levels[level]) {
+                    weighted.emplace_back(value, itemWeight);
+                }
+                total += itemWeight * static_cast<double>(m_levels[level].size());
+            }
+            if (weighted.empty()) {
+                return 0.0;
+            }
+            std::sort(weighted.begin(), weighted.end());
+            const double target = std::clamp(q, 0.0, 1.0) * total;
+            double cumulative = 0.0;
+            for (const auto& [value, weight] : weighted) {
+                cumulative += weight;
+                if (cumulative >= target) {
+                    return value;
+                }
+            }
+            return weighted.back().first;
+        }
     }
 }
\ No newline at end of file
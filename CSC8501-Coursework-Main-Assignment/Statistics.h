@@ -9,6 +9,57 @@ namespace ipd {
         double mean(const std::vector<double>& values);
         double variance(const std::vector<double>& values, double meanValue);
         std::tuple<double, double> confidenceInterval95(const std::vector<double>& values, double meanValue);
+
+        // Constant-memory mean/variance accumulator (weighted Welford update). A weight sets a
+        // sample's share of the mean and variance, but each add() is one independent sample:
+        // add(x, 2) stands for a mirrored match counted twice in the mean, not for two
+        // observations, so the standard error uses count(). Accumulators filled on different
+        // threads combine with merge() using Chan et al.'s pairwise formula.
+        class RunningStats {
+        public:
+            void add(double value, double weight = 1.0);
+            void merge(const RunningStats& other);
+
+            double weight() const;
+            std::size_t count() const; // independent samples added
+            double mean() const;
+            double variance() const;
+            std::tuple<double, double> confidenceInterval95() const;
+
+        private:
+            double m_weight = 0.0;
+            std::size_t m_count = 0;
+            double m_mean = 0.0;
+            double m_sumSquares = 0.0; // sum of weighted squared deviations from the mean
+        };
+
+        // KLL quantile sketch (Karnin, Lang & Liberty, 2016): memory grows only with log(n/k) and
+        // sketches merge, with rank error roughly 1.7/k. Level h holds items that each stand for
+        // 2^h inputs. Compaction keeps alternate items from a per-level toggle instead of a random
+        // coin, so the result depends only on the order of the inputs. Up to about k inputs it is exact.
+        class QuantileSketch {
+        public:
+            explicit QuantileSketch(std::size_t k = 200);
+
+            // Whole-number frequency weight: add(x, 2) inserts x twice.
+            void add(double value, double weight = 1.0);
+            void merge(const QuantileSketch& other);
+
+            // Smallest retained value whose cumulative weight reaches q of the total (nearest rank).
+            double quantile(double q) const;
+
+        private:
+            std::size_t capacity(std::size_t level) const;
+            void addLevel();
+            void compress();
+            void compact(std::size_t level);
+
+            std::size_t m_k;
+            std::vector<std::vector<double>> m_levels;
+            std::vector<std::size_t> m_offsets; // which element of each pair survives the next compaction
+            std::size_t m_size = 0;
+            std::size_t m_maxSize = 0;
+        };
     }
 }
 
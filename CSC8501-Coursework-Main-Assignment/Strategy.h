@@ -1,13 +1,26 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "MatchState.h"
 #include "Move.h"
 #include "Random.h"
 
 namespace ipd {
+    // A strategy as a finite automaton over recorded rounds. State 0 opens the match; in state s
+    // the strategy cooperates with probability cooperate[s] and, once the round is recorded
+    // (after noise), moves to next[s][2 * own + opponent], counting Defect as 1.
+    struct TransitionTable {
+        std::vector<double> cooperate;
+        std::vector<std::array<std::size_t, 4>> next;
+    };
+
     class Strategy {
     public:
         virtual ~Strategy() = default;
@@ -17,6 +30,17 @@ namespace ipd {
         virtual void onMatchEnd(const MatchState& state, int selfIndex) { (void)state; (void)selfIndex; }
         virtual void reset() {}
         virtual int complexity() const { return 1; }
+        // How many past rounds nextMove reads; the engine keeps only that much history.
+        virtual std::size_t historyDepth() const { return MatchState::kUnboundedHistory; }
+        // Deterministic strategies may expose their internal state. The snapshot together with
+        // the last round must fully determine every future move; randomised strategies return nullopt.
+        virtual std::optional<std::uint64_t> stateSnapshot() const { return std::nullopt; }
+        // True when the moves depend only on the history, never on the random stream, so a
+        // noise-free match between two such strategies always produces the same report.
+        virtual bool isDeterministic() const { return false; }
+        // Strategies that are such an automaton can export it, so a match between two of them
+        // can be evaluated exactly as a Markov chain instead of sampled.
+        virtual std::optional<TransitionTable> transitionTable() const { return std::nullopt; }
     };
 
     using StrategyPtr = std::unique_ptr<Strategy>;
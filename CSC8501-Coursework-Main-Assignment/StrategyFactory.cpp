@@ -1,6 +1,7 @@
 #include "StrategyFactory.h"
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -12,6 +13,7 @@
 #include "Empath.h"
 #include "Reflector.h"
 #include "GRIM.h"
+#include "MEM1.h"
 #include "PAVLOV.h"
 #include "PROBER.h"
 #include "RND.h"
@@ -41,6 +43,31 @@ namespace ipd {
             }
             return probability;
         }
+
+        std::optional<std::array<double, 4>> parseMemoryOne(const std::string& name) {
+            if (name.substr(0, 5) != "MEM1(") {
+                return std::nullopt;
+            }
+            if (name.back() != ')') {
+                throw std::runtime_error("Invalid MEM1 strategy format: " + name);
+            }
+            std::stringstream stream(name.substr(5, name.size() - 6));
+            std::array<double, 4> cooperate{};
+            for (std::size_t outcome = 0; outcome < cooperate.size(); ++outcome) {
+                char separator = ',';
+                if ((outcome > 0 && !(stream >> separator)) || separator != ',' || !(stream >> cooperate[outcome])) {
+                    throw std::runtime_error("MEM1 needs four probabilities (pCC,pCD,pDC,pDD): " + name);
+                }
+                if (cooperate[outcome] < 0.0 || cooperate[outcome] > 1.0) {
+                    throw std::runtime_error("MEM1 probabilities must be between 0 and 1: " + name);
+                }
+            }
+            stream >> std::ws;
+            if (!stream.eof()) {
+                throw std::runtime_error("MEM1 needs four probabilities (pCC,pCD,pDC,pDD): " + name);
+            }
+            return cooperate;
+        }
     }
 
     StrategyFactory& StrategyFactory::instance() {
@@ -52,6 +79,9 @@ namespace ipd {
         if (const auto probability = parseRandomProbability(name)) {
             return std::make_unique<RND>(*probability);
         }
+        if (const auto cooperate = parseMemoryOne(name)) {
+            return std::make_unique<MEM1>(*cooperate);
+        }
         auto it = m_creators.find(name);
         if (it == m_creators.end()) {
             throw std::runtime_error("Unknown strategy: " + name);
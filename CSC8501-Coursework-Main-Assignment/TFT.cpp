@@ -15,4 +15,21 @@ namespace ipd {
     int TFT::complexity() const {
         return 2;
     }
+
+    std::size_t TFT::historyDepth() const {
+        return 1;
+    }
+
+    bool TFT::isDeterministic() const {
+        return true;
+    }
+
+    std::optional<std::uint64_t> TFT::stateSnapshot() const {
+        return 0;
+    }
+
+    // State 1: the opponent defected last round.
+    std::optional<TransitionTable> TFT::transitionTable() const {
+        return TransitionTable{ { 1.0, 0.0 }, { { 0, 1, 0, 1 }, { 0, 1, 0, 1 } } };
+    }
 }
\ No newline at end of file
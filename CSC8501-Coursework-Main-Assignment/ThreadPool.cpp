@@ -0,0 +1,89 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace ipd {
+    ThreadPool::ThreadPool(std::size_t workers)
+        : m_workers(std::max<std::size_t>(1, workers)) {
+        m_threads.reserve(m_workers - 1);
+        for (std::size_t index = 1; index < m_workers; ++index) {
+            m_threads.emplace_back(&ThreadPool::workerLoop, this, index);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    std::size_t ThreadPool::size() const {
+        return m_workers;
+    }
+
+    void ThreadPool::run(const Job& job) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = &job;
+            m_pending = m_threads.size();
+            m_error = nullptr;
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        try {
+            job(0);
+        }
+        catch (...) {
+            recordError(std::current_exception());
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_finished.wait(lock, [this]() { return m_pending == 0; });
+        m_job = nullptr;
+        if (m_error) {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+    void ThreadPool::workerLoop(std::size_t workerIndex) {
+        std::size_t seenGeneration = 0;
+        for (;;) {
+            const Job* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [&]() { return m_stopping || m_generation != seenGeneration; });
+                if (m_stopping) {
+                    return;
+                }
+                seenGeneration = m_generation;
+                job = m_job;
+            }
+
+            try {
+                (*job)(workerIndex);
+            }
+            catch (...) {
+                recordError(std::current_exception());
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_pending;
+            }
+            m_finished.notify_one();
+        }
+    }
+
+    void ThreadPool::recordError(std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_error) {
+            m_error = error;
+        }
+    }
+}
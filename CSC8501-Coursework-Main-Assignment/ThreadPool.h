@@ -0,0 +1,43 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ipd {
+    // Fixed set of worker threads that stay alive for the lifetime of the pool.
+    // run() hands the same job to every worker (the calling thread acts as worker 0)
+    // and blocks until all of them have returned.
+    class ThreadPool {
+    public:
+        using Job = std::function<void(std::size_t workerIndex)>;
+
+        explicit ThreadPool(std::size_t workers);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        std::size_t size() const;
+        void run(const Job& job);
+
+    private:
+        void workerLoop(std::size_t workerIndex);
+        void recordError(std::exception_ptr error);
+
+        std::size_t m_workers;
+        std::vector<std::thread> m_threads;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_finished;
+        const Job* m_job = nullptr;
+        std::size_t m_generation = 0;
+        std::size_t m_pending = 0;
+        bool m_stopping = false;
+        std::exception_ptr m_error;
+    };
+}
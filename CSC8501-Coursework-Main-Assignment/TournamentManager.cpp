@@ -1,32 +1,33 @@
-#include "TournamentManager.h"
+﻿#include "TournamentManager.h"
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iterator>
-#include <map>
 #include <numeric>
 #include <optional>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "LockstepKernel.h"
+#include "Logger.h"
+#include "MEM1.h"
+#include "MarkovMatch.h"
 #include "Match.h"
+#include "MatchCache.h"
 #include "Statistics.h"
 #include "StrategyFactory.h"
 #include "Random.h"
+#include "ThreadPool.h"
 
 namespace ipd {
     namespace {
-        struct MatchMetrics {
-            double cooperations = 0.0;
-            double rounds = 0.0;
-            std::optional<int> firstDefection;
-            double echoLengthSum = 0.0;
-            std::size_t echoSamples = 0;
-        };
-
         struct StrategyAggregate {
-            std::vector<double> scores;
-            std::optional<double> complexity;
-            std::optional<double> cost;
+            statistics::RunningStats scores; // weighted by the samples each score stands for (2 for a mirrored pair in symmetric mode); one count per match seat
+            statistics::QuantileSketch quantiles;
             double cooperationTotal = 0.0;
             double roundTotal = 0.0;
             double firstDefectionTotal = 0.0;
@@ -35,19 +36,6 @@ namespace ipd {
             std::size_t echoLengthSamples = 0;
         };
 
-        using MatchPair = std::pair<std::string, std::string>;
-
-        std::vector<MatchPair> generateMatchPairs(const std::vector<std::string>& strategyNames) {
-            std::vector<MatchPair> pairs;
-            pairs.reserve(strategyNames.size() * strategyNames.size());
-            for (const auto& firstName : strategyNames) {
-                std::transform(strategyNames.begin(), strategyNames.end(), std::back_inserter(pairs), [&](const std::string& secondName) {
-                    return MatchPair{ firstName, secondName };
-                    });
-            }
-            return pairs;
-        }
-
         double scbCostFor(const std::string& name, const Strategy& strategy, const Config& config) {
             if (!config.scbEnabled) {
                 return 0.0;
@@ -59,90 +47,212 @@ namespace ipd {
             return static_cast<double>(strategy.complexity());
         }
 
-        MatchMetrics computeMetrics(const MatchState& state, int playerIndex, int totalRounds) {
-            MatchMetrics metrics;
-            (void)totalRounds;
+        // Strategy names resolved once per tournament. A strategy's ID is the position of its
+        // first appearance in config.strategyNames (repeated names share an ID) and indexes
+        // every per-strategy array below.
+        struct StrategyRoster {
+            std::vector<std::string> names;
+            std::vector<std::size_t> entryIds; // ID of each config.strategyNames entry
+            std::vector<double> complexity;
+            std::vector<double> cost;
+        };
 
-            const auto& history = state.history();
-            metrics.rounds = static_cast<double>(history.size());
+        StrategyRoster buildRoster(const Config& config) {
+            const StrategyFactory& factory = StrategyFactory::instance();
+            StrategyRoster roster;
+            std::unordered_map<std::string, std::size_t> ids;
+            roster.entryIds.reserve(config.strategyNames.size());
+            for (const auto& name : config.strategyNames) {
+                const auto [entry, inserted] = ids.emplace(name, roster.names.size());
+                if (inserted) {
+                    const StrategyPtr strategy = factory.create(name);
+                    roster.names.push_back(name);
+                    roster.complexity.push_back(static_cast<double>(strategy->complexity()));
+                    roster.cost.push_back(scbCostFor(name, *strategy, config));
+                }
+                roster.entryIds.push_back(entry->second);
+            }
+            return roster;
+        }
 
-            bool lastMutualCoop = true;
-            bool inEcho = false;
-            std::size_t currentEcho = 0;
+        struct MatchPair {
+            std::size_t first; // strategy IDs
+            std::size_t second;
+            std::size_t weight = 1; // ordered matches this pairing stands in for, credited to each side
+        };
+        using AggregateTable = std::vector<StrategyAggregate>; // indexed by strategy ID
 
-            for (std::size_t index = 0; index < history.size(); ++index) {
-                const auto& round = history[index];
-                const Move self = playerIndex == 0 ? round.first : round.second;
-                const Move opponent = playerIndex == 0 ? round.second : round.first;
+        std::vector<MatchPair> generateMatchPairs(const std::vector<std::size_t>& entryIds) {
+            std::vector<MatchPair> pairs;
+            pairs.reserve(entryIds.size() * entryIds.size());
+            for (const std::size_t firstId : entryIds) {
+                std::transform(entryIds.begin(), entryIds.end(), std::back_inserter(pairs), [&](std::size_t secondId) {
+                    return MatchPair{ firstId, secondId };
+                    });
+            }
+            return pairs;
+        }
 
-                if (self == Move::Cooperate) {
-                    metrics.cooperations += 1.0;
+        // Unordered pairs plus the self-play diagonal. A-vs-B also stands for B-vs-A, so both
+        // sides are credited twice; on the diagonal each side already is one of the two
+        // ordered samples. Per-strategy sample weights therefore equal the ordered schedule's, so
+        // the means match; CIs and sample counts still follow the matches actually played.
+        std::vector<MatchPair> generateSymmetricPairs(const std::vector<std::size_t>& entryIds) {
+            std::vector<MatchPair> pairs;
+            pairs.reserve(entryIds.size() * (entryIds.size() + 1) / 2);
+            for (std::size_t firstIndex = 0; firstIndex < entryIds.size(); ++firstIndex) {
+                for (std::size_t secondIndex = firstIndex; secondIndex < entryIds.size(); ++secondIndex) {
+                    pairs.push_back(MatchPair{ entryIds[firstIndex], entryIds[secondIndex], firstIndex == secondIndex ? 1u : 2u });
                 }
+            }
+            return pairs;
+        }
 
-                if (!metrics.firstDefection && self == Move::Defect) {
-                    metrics.firstDefection = static_cast<int>(index) + 1;
-                }
+        std::vector<MatchPair> scheduleFor(const Config& config, const StrategyRoster& roster) {
+            return config.symmetric ? generateSymmetricPairs(roster.entryIds) : generateMatchPairs(roster.entryIds);
+        }
 
-                const bool mutualCooperate = (self == Move::Cooperate && opponent == Move::Cooperate);
+        void accumulateScore(StrategyAggregate& aggregate, double score, double weight, const MatchMetrics& metrics) {
+            aggregate.scores.add(score, weight);
+            aggregate.quantiles.add(score, weight);
+            aggregate.cooperationTotal += weight * metrics.cooperations;
+            aggregate.roundTotal += weight * metrics.rounds;
+            if (metrics.firstDefection) {
+                aggregate.firstDefectionTotal += weight * static_cast<double>(*metrics.firstDefection);
+                aggregate.firstDefectionSamples += static_cast<std::size_t>(weight);
+            }
+            aggregate.echoLengthTotal += weight * metrics.echoLengthSum;
+            aggregate.echoLengthSamples += static_cast<std::size_t>(weight) * metrics.echoSamples;
+        }
 
-                if (inEcho) {
-                    ++currentEcho;
-                }
-                else if (lastMutualCoop && !mutualCooperate) {
-                    inEcho = true;
-                    currentEcho = 1;
-                }
+        struct MatchStreams {
+            RandomEngine engine = RandomEngine::Philox;
+            unsigned int baseSeed = 0;
+            Random* shared = nullptr; // legacy mt19937 path: one stream for the whole schedule, played in order
+        };
 
-                if (mutualCooperate) {
-                    if (inEcho) {
-                        metrics.echoLengthSum += static_cast<double>(currentEcho);
-                        metrics.echoSamples += 1;
-                        inEcho = false;
-                        currentEcho = 0;
-                    }
-                    lastMutualCoop = true;
-                }
-                else {
-                    lastMutualCoop = false;
-                }
+        MatchReport playWithStreams(Match& match, Strategy& first, Strategy& second, int rounds, const MatchStreams& streams, int repeat, std::size_t pairIndex) {
+            if (streams.shared != nullptr) {
+                return match.play(first, second, rounds, *streams.shared);
             }
+            const auto repeatKey = static_cast<std::uint32_t>(repeat);
+            const auto pairKey = static_cast<std::uint32_t>(pairIndex);
+            Random rngFirst = Random::stream(streams.baseSeed, repeatKey, pairKey, 0, streams.engine);
+            Random rngSecond = Random::stream(streams.baseSeed, repeatKey, pairKey, 1, streams.engine);
+            return match.play(first, second, rounds, rngFirst, rngSecond);
+        }
 
-            if (inEcho && currentEcho > 0) {
-                metrics.echoLengthSum += static_cast<double>(currentEcho);
-                metrics.echoSamples += 1;
+        // Both players draw from streams keyed by the match's place in the schedule, so
+        // the outcome does not depend on which worker plays it or when. When a cache is
+        // given (noise-free runs only) deterministic pairings are simulated once per process;
+        // they draw nothing from their streams, so skipping them leaves the others unchanged.
+        MatchReport playScheduledMatch(Match& match, Strategy& first, Strategy& second, const MatchPair& pair, const StrategyRoster& roster, int rounds, const MatchStreams& streams, int repeat, std::size_t pairIndex, MatchCache* cache = nullptr) {
+            const bool memoise = cache != nullptr && first.isDeterministic() && second.isDeterministic();
+            const std::string& firstName = roster.names[pair.first];
+            const std::string& secondName = roster.names[pair.second];
+            if (memoise) {
+                if (auto cached = cache->find(firstName, secondName, rounds, match.payoff())) {
+                    return std::move(*cached);
+                }
             }
-
-            return metrics;
+            MatchReport report = playWithStreams(match, first, second, rounds, streams, repeat, pairIndex);
+            if (memoise) {
+                cache->store(firstName, secondName, rounds, match.payoff(), report);
+            }
+            return report;
         }
 
-        void accumulateScore(StrategyAggregate& aggregate, double score, double complexity, double cost, const MatchMetrics& metrics) {
-            aggregate.scores.push_back(score);
-            if (!aggregate.complexity.has_value()) {
-                aggregate.complexity = complexity;
+        // Two instances per strategy ID, one per seat so self-play gets separate players.
+        // They are created once per tournament and reused, since Match::play resets them.
+        class StrategyPool {
+        public:
+            explicit StrategyPool(const StrategyRoster& roster) {
+                const StrategyFactory& factory = StrategyFactory::instance();
+                m_instances.reserve(roster.names.size());
+                for (const auto& name : roster.names) {
+                    m_instances.push_back({ factory.create(name), factory.create(name) });
+                }
             }
-            if (!aggregate.cost.has_value()) {
-                aggregate.cost = cost;
+
+            Strategy& seat(std::size_t id, int seatIndex) const {
+                return *m_instances[id][seatIndex];
             }
-            aggregate.cooperationTotal += metrics.cooperations;
-            aggregate.roundTotal += metrics.rounds;
-            if (metrics.firstDefection) {
-                aggregate.firstDefectionTotal += static_cast<double>(*metrics.firstDefection);
-                aggregate.firstDefectionSamples += 1;
+
+        private:
+            std::vector<std::array<StrategyPtr, 2>> m_instances;
+        };
+
+        // Per-cell score statistics behind a PayoffMatrix, row-major by strategy ID; empty when no
+        // matrix was requested.
+        using PairTable = std::vector<statistics::RunningStats>;
+
+        // Reports of lock-step pairings played ahead for the chunk of the schedule starting at
+        // `begin`, indexed by matchIndex - begin.
+        struct LockstepAhead {
+            std::size_t begin = 0;
+            std::vector<MatchReport> reports;
+            std::vector<char> ready;
+            std::vector<Random> rngFirst;
+            std::vector<Random> rngSecond;
+            std::vector<MatchReport> lanes;
+        };
+
+        // Everything one worker mutates while playing its slice of the schedule.
+        struct WorkerContext {
+            Match match;
+            StrategyPool strategies;
+            LockstepKernel lockstep;
+            LockstepAhead ahead;
+        };
+
+        // One match's per-round scores and metrics, held until it is accumulated.
+        struct PlayedMatch {
+            double averageFirst = 0.0;
+            double averageSecond = 0.0;
+            MatchMetrics metricsFirst;
+            MatchMetrics metricsSecond;
+        };
+
+        // Matches are played in blocks of at most this many (more when lock-step needs whole
+        // 64-repeat chunks per worker, up to kMaxBlockMatches), bounding the buffer of
+        // PlayedMatch records between playing and accumulating.
+        constexpr std::size_t kBlockMatches = std::size_t{ 1 } << 16;
+        constexpr std::size_t kMaxBlockMatches = std::size_t{ 1 } << 20;
+
+        PayoffMatrix buildMatrix(const PairTable& pairs, const StrategyRoster& roster, int repeatsPlayed) {
+            PayoffMatrix matrix;
+            matrix.names = roster.names;
+            matrix.repeats = repeatsPlayed;
+            matrix.cells.reserve(pairs.size());
+            for (const auto& stats : pairs) {
+                const auto [ciLow, ciHigh] = stats.confidenceInterval95();
+                matrix.cells.push_back(PayoffCell{ stats.mean(), ciLow, ciHigh, stats.count() });
             }
-            aggregate.echoLengthTotal += metrics.echoLengthSum;
-            aggregate.echoLengthSamples += metrics.echoSamples;
+            return matrix;
+        }
+
+        double ciWidth(const StrategyAggregate& aggregate) {
+            const auto [low, high] = aggregate.scores.confidenceInterval95();
+            return high - low;
         }
 
-        std::vector<Result> buildResults(const std::map<std::string, StrategyAggregate>& aggregates, const Config& config) {
+        // Results start in roster (configuration) order; the stable sort keeps that order among ties.
+        std::vector<Result> buildResults(const AggregateTable& aggregates, const StrategyRoster& roster, const Config& config,
+            int repeatsPlayed, const std::vector<int>& repeatsNeeded, const std::vector<char>& exactPairings,
+            const std::vector<char>& exactOnly) {
             std::vector<Result> results;
             results.reserve(aggregates.size());
-            std::transform(aggregates.begin(), aggregates.end(), std::back_inserter(results), [&](const auto& entry) {
-                const auto& name = entry.first;
-                const auto& aggregate = entry.second;
-                const double mean = statistics::mean(aggregate.scores);
-                const double variance = statistics::variance(aggregate.scores, mean);
+            for (std::size_t id = 0; id < aggregates.size(); ++id) {
+                const auto& name = roster.names[id];
+                const auto& aggregate = aggregates[id];
+                const double mean = aggregate.scores.mean();
+                const double variance = aggregate.scores.variance();
                 const double stdev = std::sqrt(variance);
-                const auto [ciLow, ciHigh] = statistics::confidenceInterval95(aggregate.scores, mean);
+                // The spread of an exact-only strategy is across opponents, not repeats: its mean
+                // has no sampling error, so the CI collapses onto it.
+                const auto [ciLow, ciHigh] = exactOnly[id]
+                    ? std::pair<double, double>{ mean, mean }
+                    : aggregate.scores.confidenceInterval95();
 
                 Result result;
                 result.strategy = name;
@@ -151,26 +261,37 @@ namespace ipd {
                 result.stdev = stdev;
                 result.ciLow = ciLow;
                 result.ciHigh = ciHigh;
+                result.p05 = aggregate.quantiles.quantile(0.05);
+                result.p50 = aggregate.quantiles.quantile(0.50);
+                result.p95 = aggregate.quantiles.quantile(0.95);
                 result.coopRate = aggregate.roundTotal > 0.0 ? aggregate.cooperationTotal / aggregate.roundTotal : 0.0;
-                if (aggregate.firstDefectionSamples > 0) {
-                    result.firstDefection = aggregate.firstDefectionTotal / static_cast<double>(aggregate.firstDefectionSamples);
-                }
-                result.echoLength = aggregate.echoLengthSamples > 0
-                    ? aggregate.echoLengthTotal / static_cast<double>(aggregate.echoLengthSamples)
-                    : 0.0;
-                result.complexity = aggregate.complexity.value_or(0.0);
-                result.samples = aggregate.scores.size();
-                result.cost = aggregate.cost.value_or(0.0);
+                // Exact pairings yield no per-match timelines, so an average over the rest would
+                // silently cover only part of the strategy's opponents; both columns read NA instead.
+                if (!exactPairings[id]) {
+                    if (aggregate.firstDefectionSamples > 0) {
+                        result.firstDefection = aggregate.firstDefectionTotal / static_cast<double>(aggregate.firstDefectionSamples);
+                    }
+                    result.echoLength = aggregate.echoLengthSamples > 0
+                        ? aggregate.echoLengthTotal / static_cast<double>(aggregate.echoLengthSamples)
+                        : 0.0;
+                }
+                result.complexity = roster.complexity[id];
+                result.samples = aggregate.scores.count();
+                result.cost = roster.cost[id];
                 result.netMean = result.mean - (config.scbEnabled ? result.cost : 0.0);
-                return result;
-                });
+                result.repeats = repeatsPlayed;
+                if (repeatsNeeded[id] > 0) {
+                    result.repeatsNeeded = repeatsNeeded[id];
+                }
+                results.push_back(result);
+            }
             if (config.scbEnabled) {
-                std::sort(results.begin(), results.end(), [](const Result& lhs, const Result& rhs) {
+                std::stable_sort(results.begin(), results.end(), [](const Result& lhs, const Result& rhs) {
                     return lhs.netMean > rhs.netMean;
                     });
             }
             else {
-                std::sort(results.begin(), results.end(), [](const Result& lhs, const Result& rhs) {
+                std::stable_sort(results.begin(), results.end(), [](const Result& lhs, const Result& rhs) {
                     return lhs.mean > rhs.mean;
                     });
             }
@@ -178,52 +299,319 @@ namespace ipd {
         }
     }
 
+    TournamentManager::TournamentManager() = default;
+    TournamentManager::~TournamentManager() = default;
+
+    ThreadPool& TournamentManager::pool(std::size_t workers) const {
+        if (!m_pool || m_pool->size() != workers) {
+            m_pool.reset();
+            m_pool = std::make_unique<ThreadPool>(workers);
+        }
+        return *m_pool;
+    }
+
     std::vector<Result> TournamentManager::run(const Config& config) const {
+        return play(config, nullptr);
+    }
+
+    std::vector<Result> TournamentManager::run(const Config& config, PayoffMatrix& matrix) const {
+        return play(config, &matrix);
+    }
+
+    std::vector<Result> TournamentManager::play(const Config& config, PayoffMatrix* matrix) const {
         registerBuiltinStrategies();
 
         if (config.repeats <= 0 || config.rounds <= 0) {
             return {};
         }
 
-        StrategyFactory& factory = StrategyFactory::instance();
-
-        Random rng;
+        Random seeder;
         if (config.useSeed) {
-            rng.reseed(config.seed);
+            seeder.reseed(config.seed);
+        }
+        MatchStreams streams;
+        streams.engine = randomEngineFromName(config.rngEngine);
+        streams.baseSeed = config.useSeed ? config.seed : static_cast<unsigned int>(seeder());
+        if (streams.engine == RandomEngine::Mt19937) {
+            streams.shared = &seeder;
         }
-
-        std::map<std::string, StrategyAggregate> aggregates;
 
         Match match(config.payoffs, config.epsilon);
+        match.setCycleSkip(config.cycleSkip);
+        match.setExactHorizon(exactHorizonFromName(config.horizon));
+        MatchCache* cache = config.matchCache && config.epsilon <= 0.0 ? &MatchCache::instance() : nullptr;
 
-        const auto matchPairs = generateMatchPairs(config.strategyNames);
+        const StrategyRoster roster = buildRoster(config);
+        const auto matchPairs = scheduleFor(config, roster);
         if (matchPairs.empty()) {
             return {};
         }
 
-        const auto rounds = static_cast<double>(config.rounds);
-        auto playMatch = [&](const MatchPair& pair) {
-            StrategyPtr first = factory.create(pair.first);
-            StrategyPtr second = factory.create(pair.second);
+        const std::size_t pairCount = matchPairs.size();
+        const std::size_t firstBatchMatches = pairCount * static_cast<std::size_t>(config.repeats);
+        const std::size_t requestedWorkers = streams.shared != nullptr ? 1 : static_cast<std::size_t>(std::max(1, config.threads));
+        const std::size_t workerCount = std::min<std::size_t>(requestedWorkers, firstBatchMatches);
+        const std::size_t strategyCount = roster.names.size();
+        const std::size_t matrixCells = matrix != nullptr ? strategyCount * strategyCount : 0;
+        std::vector<WorkerContext> workers;
+        workers.reserve(workerCount);
+        for (std::size_t worker = 0; worker < workerCount; ++worker) {
+            workers.push_back(WorkerContext{ match, StrategyPool(roster), LockstepKernel(config.payoffs, config.epsilon), LockstepAhead{} });
+        }
+        AggregateTable aggregates(strategyCount);
+        PairTable pairs(matrixCells);
+
+        // With --exact, pairings of two strategies that export a transition table are evaluated
+        // once as a Markov chain, and every repeat credits that expected report. MEM1-vs-MEM1
+        // pairings always are: a field of memory-one variants is what the chain is for. When
+        // every pairing is exact, further repeats would only add copies, so one is played.
+        std::vector<std::optional<MatchReport>> exactReports(pairCount);
+        for (std::size_t pairIndex = 0; pairIndex < pairCount; ++pairIndex) {
+            const MatchPair& pair = matchPairs[pairIndex];
+            const Strategy& first = workers.front().strategies.seat(pair.first, 0);
+            const Strategy& second = workers.front().strategies.seat(pair.second, 1);
+            if (config.exact || (typeid(first) == typeid(MEM1) && typeid(second) == typeid(MEM1))) {
+                exactReports[pairIndex] = match.expected(first, second, config.rounds);
+            }
+        }
+        const bool allExact = std::all_of(exactReports.begin(), exactReports.end(), [](const auto& report) {
+            return report.has_value();
+            });
+        std::vector<char> exactPairings(strategyCount, 0);
+        std::vector<char> exactOnly(strategyCount, 1);
+        for (std::size_t pairIndex = 0; pairIndex < pairCount; ++pairIndex) {
+            const MatchPair& pair = matchPairs[pairIndex];
+            if (exactReports[pairIndex]) {
+                exactPairings[pair.first] = exactPairings[pair.second] = 1;
+            }
+            else {
+                exactOnly[pair.first] = exactOnly[pair.second] = 0;
+            }
+        }
 
-            const MatchReport report = match.play(*first, *second, config.rounds, rng);
-            const double averageFirst = report.scoreFirst / rounds;
-            const double averageSecond = report.scoreSecond / rounds;
+        // Pairings of two bit-state built-ins or Reflectors are played up to 64 repeats at a
+        // time by the lock-step kernel. It needs per-match streams, and noise-free deterministic
+        // pairings already come from the match cache when that is on.
+        std::vector<std::optional<LockstepKind>> lockstepKinds(strategyCount);
+        for (std::size_t id = 0; id < strategyCount; ++id) {
+            lockstepKinds[id] = lockstepKindOf(workers.front().strategies.seat(id, 0));
+        }
+        std::vector<char> lockstepPairs(pairCount, 0);
+        if (config.lockstep && streams.shared == nullptr && cache == nullptr) {
+            for (std::size_t pairIndex = 0; pairIndex < pairCount; ++pairIndex) {
+                lockstepPairs[pairIndex] = lockstepKinds[matchPairs[pairIndex].first] && lockstepKinds[matchPairs[pairIndex].second]
+                    && !exactReports[pairIndex];
+            }
+        }
+        const bool useLockstep = std::find(lockstepPairs.begin(), lockstepPairs.end(), 1) != lockstepPairs.end();
+
+        // Plays every lock-step pairing scheduled in [begin, end); the range spans at most
+        // kLanes repeats, so each pairing fits one kernel call.
+        auto playAhead = [&](std::size_t begin, std::size_t end, WorkerContext& context) {
+            LockstepAhead& ahead = context.ahead;
+            ahead.begin = begin;
+            ahead.reports.resize(end - begin);
+            ahead.ready.assign(end - begin, 0);
+            for (std::size_t pairIndex = 0; pairIndex < pairCount; ++pairIndex) {
+                if (!lockstepPairs[pairIndex]) {
+                    continue;
+                }
+                const std::size_t firstMatch = begin + (pairIndex + pairCount - begin % pairCount) % pairCount;
+                if (firstMatch >= end) {
+                    continue;
+                }
+                ahead.rngFirst.clear();
+                ahead.rngSecond.clear();
+                for (std::size_t matchIndex = firstMatch; matchIndex < end; matchIndex += pairCount) {
+                    const auto repeatKey = static_cast<std::uint32_t>(matchIndex / pairCount);
+                    const auto pairKey = static_cast<std::uint32_t>(pairIndex);
+                    ahead.rngFirst.push_back(Random::stream(streams.baseSeed, repeatKey, pairKey, 0, streams.engine));
+                    ahead.rngSecond.push_back(Random::stream(streams.baseSeed, repeatKey, pairKey, 1, streams.engine));
+                }
+                const MatchPair& pair = matchPairs[pairIndex];
+                context.lockstep.play(*lockstepKinds[pair.first], *lockstepKinds[pair.second], config.rounds, ahead.rngFirst, ahead.rngSecond, ahead.lanes);
+#ifndef NDEBUG
+                // Debug builds replay the first lane through Match::play: the kernel, and the
+                // Reflector batch's SIMD update in particular, must match the scalar path exactly.
+                const MatchReport scalar = playWithStreams(context.match, context.strategies.seat(pair.first, 0), context.strategies.seat(pair.second, 1),
+                    config.rounds, streams, static_cast<int>(firstMatch / pairCount), pairIndex);
+                if (scalar.scoreFirst != ahead.lanes.front().scoreFirst || scalar.scoreSecond != ahead.lanes.front().scoreSecond) {
+                    throw std::runtime_error("Lock-step kernel diverged from Match::play: " + roster.names[pair.first] + " vs " + roster.names[pair.second]);
+                }
+#endif
+                std::size_t lane = 0;
+                for (std::size_t matchIndex = firstMatch; matchIndex < end; matchIndex += pairCount) {
+                    ahead.reports[matchIndex - begin] = std::move(ahead.lanes[lane++]);
+                    ahead.ready[matchIndex - begin] = 1;
+                }
+            }
+            };
 
-            const MatchMetrics firstMetrics = computeMetrics(report.state, 0, config.rounds);
-            const MatchMetrics secondMetrics = computeMetrics(report.state, 1, config.rounds);
+        const auto rounds = static_cast<double>(config.rounds);
+        std::size_t blockBegin = 0;
+        std::size_t blockMatches = 0;
+        std::vector<PlayedMatch> played;
+        auto playMatch = [&](std::size_t matchIndex, WorkerContext& context) {
+            const int repeat = static_cast<int>(matchIndex / pairCount);
+            const std::size_t pairIndex = matchIndex % pairCount;
+            const MatchPair& pair = matchPairs[pairIndex];
+
+            MatchReport report;
+            if (exactReports[pairIndex]) {
+                report = *exactReports[pairIndex];
+            }
+            else if (useLockstep && context.ahead.ready[matchIndex - context.ahead.begin]) {
+                report = std::move(context.ahead.reports[matchIndex - context.ahead.begin]);
+            }
+            else {
+                Strategy& first = context.strategies.seat(pair.first, 0);
+                Strategy& second = context.strategies.seat(pair.second, 1);
+                report = playScheduledMatch(context.match, first, second, pair, roster, config.rounds, streams, repeat, pairIndex, cache);
+            }
+            played[matchIndex - blockBegin] = PlayedMatch{ report.scoreFirst / rounds, report.scoreSecond / rounds,
+                std::move(report.metricsFirst), std::move(report.metricsSecond) };
+            };
+
+        // Runs on the calling thread in schedule order, so every statistic (quantile sketches
+        // included) comes out bit-identical for any worker count.
+        auto accumulateMatch = [&](std::size_t matchIndex) {
+            const PlayedMatch& result = played[matchIndex - blockBegin];
+            const MatchPair& pair = matchPairs[matchIndex % pairCount];
+            const auto weight = static_cast<double>(pair.weight);
+            accumulateScore(aggregates[pair.first], result.averageFirst, weight, result.metricsFirst);
+            accumulateScore(aggregates[pair.second], result.averageSecond, weight, result.metricsSecond);
+            if (matrixCells > 0) {
+                if (pair.first == pair.second) {
+                    // Both seats of a self-play match land on the diagonal, and they are far from
+                    // independent, so the match counts once with the seats' mean.
+                    pairs[pair.first * strategyCount + pair.first].add((result.averageFirst + result.averageSecond) / 2.0, weight);
+                }
+                else {
+                    pairs[pair.first * strategyCount + pair.second].add(result.averageFirst, weight);
+                    pairs[pair.second * strategyCount + pair.first].add(result.averageSecond, weight);
+                }
+            }
+            };
 
-            const double firstCost = scbCostFor(pair.first, *first, config);
-            const double secondCost = scbCostFor(pair.second, *second, config);
+        // Repeats are played in batches of whole repeats, and each batch in blocks; each worker
+        // takes a contiguous slice of the block. With the lock-step kernel the slice is walked in
+        // chunks of kLanes repeats whose lock-step pairings are played first.
+        auto playSlice = [&](std::size_t worker) {
+            if (worker >= workerCount) {
+                return; // the pool is sized by --threads; small schedules use fewer workers
+            }
+            const std::size_t begin = blockBegin + blockMatches * worker / workerCount;
+            const std::size_t end = blockBegin + blockMatches * (worker + 1) / workerCount;
+            const std::size_t chunk = useLockstep ? LockstepKernel::kLanes * pairCount : end - begin;
+            for (std::size_t chunkBegin = begin; chunkBegin < end; chunkBegin += chunk) {
+                const std::size_t chunkEnd = std::min(end, chunkBegin + chunk);
+                if (useLockstep) {
+                    playAhead(chunkBegin, chunkEnd, workers[worker]);
+                }
+                for (std::size_t matchIndex = chunkBegin; matchIndex < chunkEnd; ++matchIndex) {
+                    playMatch(matchIndex, workers[worker]);
+                }
+            }
+            };
 
-            accumulateScore(aggregates[pair.first], averageFirst, static_cast<double>(first->complexity()), firstCost, firstMetrics);
-            accumulateScore(aggregates[pair.second], averageSecond, static_cast<double>(second->complexity()), secondCost, secondMetrics);
+        ThreadPool* workerPool = workerCount > 1 ? &pool(requestedWorkers) : nullptr;
+        const std::size_t blockLimit = useLockstep
+            ? std::clamp(LockstepKernel::kLanes * pairCount * workerCount, kBlockMatches, kMaxBlockMatches)
+            : kBlockMatches;
+        auto playRepeats = [&](int fromRepeat, int toRepeat) {
+            const std::size_t batchEnd = pairCount * static_cast<std::size_t>(toRepeat);
+            for (blockBegin = pairCount * static_cast<std::size_t>(fromRepeat); blockBegin < batchEnd; blockBegin += blockMatches) {
+                blockMatches = std::min(blockLimit, batchEnd - blockBegin);
+                played.resize(blockMatches);
+                if (workerPool != nullptr) {
+                    workerPool->run(playSlice);
+                }
+                else {
+                    playSlice(0);
+                }
+                for (std::size_t matchIndex = blockBegin; matchIndex < blockBegin + blockMatches; ++matchIndex) {
+                    accumulateMatch(matchIndex);
+                }
+            }
             };
 
-        for (int repeat = 0; repeat < config.repeats; ++repeat) {
-            std::for_each(matchPairs.begin(), matchPairs.end(), playMatch);
+        int repeatsPlayed = allExact ? 1 : config.repeats;
+        if (allExact) {
+            logInfo("Every pairing evaluated exactly; playing a single repeat.");
         }
+        playRepeats(0, repeatsPlayed);
+
+        // With a CI target, keep adding repeats while any strategy's 95% CI is wider than the
+        // target. The width shrinks roughly like 1/sqrt(repeats), which sizes the next batch
+        // (at most doubling the repeats so far so a noisy estimate cannot overshoot far).
+        // Stays 0 for a strategy still above the target at --max-repeats. Strategies whose pairings
+        // are all exact have no sampling error, so they meet any target at the first check.
+        std::vector<int> repeatsNeeded(roster.names.size(), allExact ? repeatsPlayed : 0);
+        while (config.ciTarget > 0.0 && !allExact) {
+            double widest = 0.0;
+            for (std::size_t id = 0; id < aggregates.size(); ++id) {
+                const double width = exactOnly[id] ? 0.0 : ciWidth(aggregates[id]);
+                if (width <= config.ciTarget) {
+                    if (repeatsNeeded[id] == 0) {
+                        repeatsNeeded[id] = repeatsPlayed;
+                    }
+                }
+                else {
+                    widest = std::max(widest, width);
+                }
+            }
+            if (widest <= 0.0 || repeatsPlayed >= config.maxRepeats) {
+                break;
+            }
+            const double ratio = widest / config.ciTarget;
+            const double estimate = std::ceil(static_cast<double>(repeatsPlayed) * ratio * ratio);
+            const int upper = std::min(config.maxRepeats, 2 * repeatsPlayed);
+            const int next = std::clamp(static_cast<int>(std::min(estimate, static_cast<double>(upper))), repeatsPlayed + 1, upper);
+            logInfo("CI width " + std::to_string(widest) + " above target after " + std::to_string(repeatsPlayed) +
+                " repeats; playing up to " + std::to_string(next));
+            playRepeats(repeatsPlayed, next);
+            repeatsPlayed = next;
+        }
+
+        if (matrix != nullptr) {
+            *matrix = buildMatrix(pairs, roster, repeatsPlayed);
+        }
+        return buildResults(aggregates, roster, config, repeatsPlayed, repeatsNeeded, exactPairings, exactOnly);
+    }
 
-        return buildResults(aggregates, config);
+    MatchReplay TournamentManager::replay(const Config& config, int repeat, std::size_t pairIndex) const {
+        registerBuiltinStrategies();
+
+        if (!config.useSeed) {
+            throw std::runtime_error("Replaying a match requires the tournament seed (--seed).");
+        }
+        MatchStreams streams;
+        streams.engine = randomEngineFromName(config.rngEngine);
+        streams.baseSeed = config.seed;
+        if (streams.engine == RandomEngine::Mt19937) {
+            throw std::runtime_error("Replaying a match requires a per-match random engine (--rng philox or xoshiro).");
+        }
+        const StrategyRoster roster = buildRoster(config);
+        const auto matchPairs = scheduleFor(config, roster);
+        const int scheduledRepeats = config.ciTarget > 0.0 ? config.maxRepeats : config.repeats;
+        if (repeat < 0 || repeat >= scheduledRepeats || pairIndex >= matchPairs.size()) {
+            throw std::runtime_error("Replay index out of range: repeat " + std::to_string(repeat) + ", pair " + std::to_string(pairIndex));
+        }
+
+        Match match(config.payoffs, config.epsilon);
+        match.setRecordTrace(true);
+        const MatchPair& pair = matchPairs[pairIndex];
+        const StrategyFactory& factory = StrategyFactory::instance();
+        StrategyPtr first = factory.create(roster.names[pair.first]);
+        StrategyPtr second = factory.create(roster.names[pair.second]);
+        MatchReport report = playScheduledMatch(match, *first, *second, pair, roster, config.rounds, streams, repeat, pairIndex);
+
+        MatchReplay replay;
+        replay.repeat = repeat;
+        replay.pairIndex = pairIndex;
+        replay.first = roster.names[pair.first];
+        replay.second = roster.names[pair.second];
+        replay.report = std::move(report);
+        return replay;
     }
 }
\ No newline at end of file
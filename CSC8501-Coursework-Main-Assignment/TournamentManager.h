@@ -1,17 +1,64 @@
 #pragma once
 
+#include <cstddef>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "Config.h"
+#include "Match.h"
 #include "Result.h"
 
 namespace ipd {
+    struct MatchReplay {
+        int repeat = 0;
+        std::size_t pairIndex = 0;
+        std::string first;
+        std::string second;
+        MatchReport report;
+    };
+
+    // Per-round score of the row strategy against the column strategy.
+    struct PayoffCell {
+        double mean = 0.0;
+        double ciLow = 0.0;
+        double ciHigh = 0.0;
+        std::size_t samples = 0;
+    };
+
+    // Mean per-round payoff of each strategy (row) against each opponent (column), over every
+    // repeat and both seatings. Rows and columns follow `names`: the distinct configured
+    // strategies in order of first appearance.
+    struct PayoffMatrix {
+        std::vector<std::string> names;
+        std::vector<PayoffCell> cells; // row-major, names.size() x names.size()
+        int repeats = 0;               // repeats played
+
+        const PayoffCell& at(std::size_t row, std::size_t column) const {
+            return cells[row * names.size() + column];
+        }
+    };
+
+    class ThreadPool;
+
     class TournamentManager {
     public:
-        TournamentManager() = default;
+        TournamentManager();
+        ~TournamentManager();
 
         std::vector<Result> run(const Config& config) const;
+        // Same tournament, also filling `matrix` from the matches it plays.
+        std::vector<Result> run(const Config& config, PayoffMatrix& matrix) const;
+        // Re-plays one scheduled match of a seeded tournament without running the others.
+        MatchReplay replay(const Config& config, int repeat, std::size_t pairIndex) const;
+
+    private:
+        std::vector<Result> play(const Config& config, PayoffMatrix* matrix) const;
+        // Worker threads kept across runs (evolution re-runs the tournament every generation);
+        // rebuilt only when the requested thread count changes.
+        ThreadPool& pool(std::size_t workers) const;
+
+        mutable std::unique_ptr<ThreadPool> m_pool;
     };
 }
\ No newline at end of file
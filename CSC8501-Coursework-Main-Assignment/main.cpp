@@ -1,12 +1,15 @@
 ﻿#include <exception>
 #include <iostream>
+#include <string>
 #include <vector>
 
 #include "Config.h"
 #include "EvolutionManager.h"
+#include "LandscapeScan.h"
 #include "Reporter.h"
 #include "TournamentManager.h"
 #include "Logger.h"
+#include "MatchCache.h"
 
 int main(int argc, char** argv) {
     try {
@@ -16,6 +19,32 @@ int main(int argc, char** argv) {
             ipd::Logger::instance().setEnabled(true);
         }
 
+        if (config.replayRepeat >= 0) {
+            ipd::TournamentManager tournament;
+            ipd::reportReplay(config, tournament.replay(config, config.replayRepeat, static_cast<std::size_t>(config.replayPair)));
+            return 0;
+        }
+
+        if (config.benchmark) {
+            ipd::EvolutionManager evolution;
+            ipd::reportBenchmark(config, evolution.benchmark(config));
+            return 0;
+        }
+
+        if (config.landscape > 0) {
+            ipd::LandscapeScanner scanner;
+            ipd::reportLandscape(config, scanner.run(config));
+            return 0;
+        }
+
+        if (config.matrix) {
+            ipd::TournamentManager tournament;
+            ipd::PayoffMatrix matrix;
+            tournament.run(config, matrix);
+            ipd::reportMatrix(config, matrix);
+            return 0;
+        }
+
         std::vector<ipd::Result> results;
         std::vector<ipd::GenerationShare> history;
 
@@ -31,6 +60,11 @@ int main(int argc, char** argv) {
             results = tournament.run(config);
         }
 
+        const ipd::MatchCache& cache = ipd::MatchCache::instance();
+        if (cache.hits() + cache.misses() > 0) {
+            ipd::logInfo("match cache: " + std::to_string(cache.hits()) + " hits, " + std::to_string(cache.misses()) + " misses");
+        }
+
         ipd::reportResults(config, results, history);
 
         if (!config.saveFile.empty()) {